@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include "attacks.hpp"
+#include "evaluation.hpp"
+#include "fen_parser.hpp"
+#include "move.hpp"
+
+#include <array>
+
+//Micro-benchmarks of the hot paths of the search. Each one runs on a few
+//positions of different phases, chosen by the argument.
+
+namespace {
+
+constexpr std::array<const char*, 3> POSITIONS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+};
+
+Position loadPosition(const std::int64_t index) {
+  static bool is_initialized = false;
+
+  if (!is_initialized) {
+    Attacks::init();
+    FenParser::getInstance().setVerbose(false);
+    is_initialized = true;
+  }
+
+  Position position;
+
+  FenParser::getInstance().setFEN(POSITIONS[index]);
+  FenParser::getInstance().init(position);
+
+  return position;
+}
+
+void BM_GenerateLegalMoves(benchmark::State& state) {
+  const Position position = loadPosition(state.range(0));
+
+  MoveList moves;
+
+  for (auto _ : state) {
+    MoveGenerator::generateLegalMoves(position, moves);
+    benchmark::DoNotOptimize(moves.size());
+  }
+
+  state.SetItemsProcessed(state.iterations() * moves.size());
+}
+
+//Make and unmake every legal move of the position.
+void BM_DoUndoMove(benchmark::State& state) {
+  Position position = loadPosition(state.range(0));
+
+  MoveList moves;
+  MoveGenerator::generateLegalMoves(position, moves);
+
+  for (auto _ : state) {
+    for (const Move move : moves) {
+      position.doMove(move);
+      benchmark::DoNotOptimize(position.key());
+      position.undoMove(move);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * moves.size());
+}
+
+void BM_EvaluateFactors(benchmark::State& state) {
+  Position position = loadPosition(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Evaluation::evaluateFactors(position));
+  }
+}
+
+//Hash the position from scratch, as opposed to the incremental update of doMove.
+void BM_ComputeKey(benchmark::State& state) {
+  const Position position = loadPosition(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(position.computeKey());
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_GenerateLegalMoves)->DenseRange(0, POSITIONS.size() - 1);
+BENCHMARK(BM_DoUndoMove)->DenseRange(0, POSITIONS.size() - 1);
+BENCHMARK(BM_EvaluateFactors)->DenseRange(0, POSITIONS.size() - 1);
+BENCHMARK(BM_ComputeKey)->DenseRange(0, POSITIONS.size() - 1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+
+#include "bitboard.hpp"
+
+// Build with -DUSE_PEXT (and -mbmi2) to index the slider tables with the
+// BMI2 PEXT instruction instead of a magic multiplication.
+#if defined(USE_PEXT)
+#include <immintrin.h>
+#endif
+
+namespace Attacks
+{
+    // Precomputed slider attacks of a single square. The relevant blockers
+    // of the square are hashed into an index of the shared attack table.
+    struct Magic
+    {
+        Bitboard::U64 mask = Bitboard::EMPTY_BITBOARD;
+        Bitboard::U64 magic = Bitboard::EMPTY_BITBOARD;
+        Bitboard::U64 *attacks = nullptr;
+        unsigned int shift = 0;
+
+        [[nodiscard]] inline unsigned int index(Bitboard::U64 occupancy) const noexcept
+        {
+#if defined(USE_PEXT)
+            return static_cast<unsigned int>(_pext_u64(occupancy, mask));
+#else
+            return static_cast<unsigned int>(((occupancy & mask) * magic) >> shift);
+#endif
+        }
+    };
+
+    extern std::array<Magic, Bitboard::NUM_OF_SQUARES> bishop_magics;
+    extern std::array<Magic, Bitboard::NUM_OF_SQUARES> rook_magics;
+
+    extern std::array<Bitboard::U64, Bitboard::NUM_OF_SQUARES> knight_attacks;
+    extern std::array<Bitboard::U64, Bitboard::NUM_OF_SQUARES> king_attacks;
+
+    // Indexed by Bitboard::sideIndex() of the pawn's side, then by its square.
+    extern std::array<std::array<Bitboard::U64, Bitboard::NUM_OF_SQUARES>, 2> pawn_attacks;
+
+    // Squares strictly between two squares on the same rank, file or diagonal.
+    extern std::array<std::array<Bitboard::U64, Bitboard::NUM_OF_SQUARES>, Bitboard::NUM_OF_SQUARES> between_squares;
+
+    // The whole rank, file or diagonal that passes through two squares.
+    extern std::array<std::array<Bitboard::U64, Bitboard::NUM_OF_SQUARES>, Bitboard::NUM_OF_SQUARES> line_squares;
+
+    // Fill the leaper masks and the slider attack tables. This must be called
+    // once on startup before any move is generated.
+    void init();
+
+    [[nodiscard]] inline Bitboard::U64 knightAttacks(int square) noexcept { return knight_attacks[square]; }
+
+    [[nodiscard]] inline Bitboard::U64 kingAttacks(int square) noexcept { return king_attacks[square]; }
+
+    [[nodiscard]] inline Bitboard::U64 between(int square_a, int square_b) noexcept
+    {
+        return between_squares[square_a][square_b];
+    }
+
+    [[nodiscard]] inline Bitboard::U64 line(int square_a, int square_b) noexcept
+    {
+        return line_squares[square_a][square_b];
+    }
+
+    // Squares attacked by a pawn of the given side.
+    [[nodiscard]] inline Bitboard::U64 pawnAttacks(int side, int square) noexcept
+    {
+        return pawn_attacks[Bitboard::sideIndex(side)][square];
+    }
+
+    [[nodiscard]] inline Bitboard::U64 bishopAttacks(int square, Bitboard::U64 occupancy) noexcept
+    {
+        const Magic &magic = bishop_magics[square];
+        return magic.attacks[magic.index(occupancy)];
+    }
+
+    [[nodiscard]] inline Bitboard::U64 rookAttacks(int square, Bitboard::U64 occupancy) noexcept
+    {
+        const Magic &magic = rook_magics[square];
+        return magic.attacks[magic.index(occupancy)];
+    }
+
+    [[nodiscard]] inline Bitboard::U64 queenAttacks(int square, Bitboard::U64 occupancy) noexcept
+    {
+        return bishopAttacks(square, occupancy) | rookAttacks(square, occupancy);
+    }
+
+    // Attacks of a bishop, rook or queen of any color.
+    [[nodiscard]] inline Bitboard::U64 sliderAttacks(int type, int square, Bitboard::U64 occupancy) noexcept
+    {
+        if (Bitboard::isBishop(type))
+        {
+            return bishopAttacks(square, occupancy);
+        }
+
+        if (Bitboard::isRook(type))
+        {
+            return rookAttacks(square, occupancy);
+        }
+
+        return queenAttacks(square, occupancy);
+    }
+} // namespace Attacks
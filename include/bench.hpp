@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+
+// A fixed search of a fixed set of positions, used to compare builds. The
+// search is single-threaded and starts every position with an empty
+// transposition table and empty move ordering statistics, so the number of
+// nodes is a signature that only changes when the behavior of the search
+// changes.
+namespace Bench
+{
+    constexpr int DEFAULT_DEPTH = 5;
+
+    // The size of the transposition table during the bench. The size that was
+    // set before is restored afterwards.
+    constexpr std::size_t HASH_MB = 16;
+
+    struct Result
+    {
+        std::uint64_t nodes = 0;
+
+        // The part of the nodes searched by the quiescence search.
+        std::uint64_t qnodes = 0;
+
+        // Milliseconds.
+        std::int64_t time = 0;
+    };
+
+    // Search every position to the depth and print the nodes of each, then the
+    // total nodes, the time and the nodes per second.
+    Result run(int depth = DEFAULT_DEPTH, std::ostream &out = std::cout);
+} // namespace Bench
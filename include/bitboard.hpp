@@ -5,6 +5,11 @@
 #include <array>
 #include <string>
 #include <bitset>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace Bitboard
 {
@@ -14,6 +19,20 @@ namespace Bitboard
 
     constexpr bool SHOULD_FLIP = false;
 
+    // One bit per square, using the same square index as the mailbox.
+    using U64 = std::uint64_t;
+
+    constexpr U64 EMPTY_BITBOARD = 0ULL;
+    constexpr int NUM_OF_PIECE_TYPES = 12;
+
+    // File and rank of a square. It has the same layout as SDL_Point, but the
+    // engine does not depend on SDL.
+    struct Coord
+    {
+        int x;
+        int y;
+    };
+
     // clang-format off
 
     enum Sides { 
@@ -62,6 +81,53 @@ namespace Bitboard
         return (should_flip ? lsr ^ 0b111000 : lsr);
     }
 
+    ////////////BITBOARD HELPERS/////////////
+    constexpr U64 squareBit(int square) noexcept { return 1ULL << square; }
+
+    inline int popCount(U64 bitboard) noexcept
+    {
+#if defined(_MSC_VER)
+        return static_cast<int>(__popcnt64(bitboard));
+#else
+        return __builtin_popcountll(bitboard);
+#endif
+    }
+
+    // Index of the least significant set bit. The bitboard must not be empty.
+    inline int getLSB(U64 bitboard) noexcept
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bitboard);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(bitboard);
+#endif
+    }
+
+    // Return the least significant square and clear it from the bitboard.
+    inline int popLSB(U64 &bitboard) noexcept
+    {
+        const int square = getLSB(bitboard);
+        bitboard &= bitboard - 1;
+        return square;
+    }
+
+    inline bool moreThanOne(U64 bitboard) noexcept { return bitboard & (bitboard - 1); }
+
+    // Map a side (BLACK = 0b01, WHITE = 0b10) into an array index.
+    constexpr int sideIndex(int side) noexcept { return side >> 1; }
+
+    // Map a piece type into an index of the piece bitboard array.
+    constexpr int pieceIndex(int type) noexcept { return type - 1; }
+
+    // Convert a white piece type (K, Q, B, N, R, P) into the piece of the given side.
+    constexpr int pieceOfSide(int white_type, int side) noexcept
+    {
+        return white_type + (side & Sides::BLACK) * 6;
+    }
+    //////////////////////////////////////////
+
     inline bool isPawn(int type) noexcept
     {
         return type == Pieces::P || type == Pieces::p;
@@ -101,7 +167,7 @@ namespace Bitboard
     }
 
     // Least significant file to coordinates.
-    [[nodiscard]] inline const SDL_Point squareToCoord(int square, bool should_flip = SHOULD_FLIP) noexcept
+    [[nodiscard]] inline const Coord squareToCoord(int square, bool should_flip = SHOULD_FLIP) noexcept
     {
         // clang-format off
         int final_square = (should_flip * flipVertically(square)) |
@@ -112,7 +178,7 @@ namespace Bitboard
     }
 
     // Least significant rank to coordinates.
-    [[nodiscard]] inline const SDL_Point lsrSquareToCoord(int lsr, int should_flip = SHOULD_FLIP) noexcept
+    [[nodiscard]] inline const Coord lsrSquareToCoord(int lsr, int should_flip = SHOULD_FLIP) noexcept
     {
         int final_lsr = (should_flip ? flipVertically(lsr) : lsr);
         return {final_lsr >> 3, final_lsr & BOARD_SIZE};
@@ -133,7 +199,7 @@ namespace Bitboard
 
     // Check if the coordniate is an empty square
     // The type must be a 2 dimensional vector.
-    template <typename T = SDL_Point>
+    template <typename T = Coord>
     inline bool isCoordEmpty(const T &vector) noexcept
     {
         return vector.x & Bitboard::Squares::no_sq ||
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+
+#include "bitboard.hpp"
+#include "attacks.hpp"
+
+// Piece placement stored as twelve piece bitboards plus occupancy masks.
+// The 64-entry mailbox is only a derived lookup for "which piece is on
+// this square" and is kept in sync by the mutators below.
+class Board
+{
+public:
+    Board();
+    ~Board();
+
+    // Remove every piece from the board.
+    void clear();
+
+    void putPiece(int square, int type);
+    void removePiece(int square);
+    void movePiece(int old_square, int new_square);
+
+    [[nodiscard]] inline int pieceAt(int square) const noexcept { return m_mailbox[square]; }
+
+    [[nodiscard]] inline bool isEmpty(int square) const noexcept
+    {
+        return !(m_all_occupancy & Bitboard::squareBit(square));
+    }
+
+    [[nodiscard]] inline Bitboard::U64 pieces(int type) const noexcept
+    {
+        return m_pieces[Bitboard::pieceIndex(type)];
+    }
+
+    // Occupancy of a side (Bitboard::Sides::BLACK or Bitboard::Sides::WHITE).
+    [[nodiscard]] inline Bitboard::U64 occupancy(int side) const noexcept
+    {
+        return m_occupancy[Bitboard::sideIndex(side)];
+    }
+
+    [[nodiscard]] inline Bitboard::U64 occupancy() const noexcept { return m_all_occupancy; }
+
+    // Square of the king of a side, or Bitboard::Squares::no_sq if it is missing.
+    [[nodiscard]] inline int kingSquare(int side) const noexcept
+    {
+        return m_king_squares[Bitboard::sideIndex(side)];
+    }
+
+    // Pieces of both sides that attack the square, given the occupancy.
+    [[nodiscard]] Bitboard::U64 attackersTo(int square, Bitboard::U64 occupancy) const noexcept;
+
+    [[nodiscard]] bool isSquareAttacked(int square, int by_side) const noexcept;
+
+    [[nodiscard]] inline const std::array<int, Bitboard::NUM_OF_SQUARES> &mailbox() const noexcept
+    {
+        return m_mailbox;
+    }
+
+private:
+    std::array<Bitboard::U64, Bitboard::NUM_OF_PIECE_TYPES> m_pieces;
+    std::array<Bitboard::U64, 2> m_occupancy;
+    Bitboard::U64 m_all_occupancy;
+
+    std::array<int, 2> m_king_squares;
+
+    std::array<int, Bitboard::NUM_OF_SQUARES> m_mailbox;
+};
+
+inline void Board::putPiece(int square, int type)
+{
+    if (m_mailbox[square] != Bitboard::Pieces::e)
+    {
+        removePiece(square);
+    }
+
+    if (type == Bitboard::Pieces::e)
+    {
+        return;
+    }
+
+    const Bitboard::U64 bit = Bitboard::squareBit(square);
+
+    m_pieces[Bitboard::pieceIndex(type)] |= bit;
+    m_occupancy[Bitboard::sideIndex(Bitboard::getColor(type))] |= bit;
+    m_all_occupancy |= bit;
+
+    m_mailbox[square] = type;
+
+    if (Bitboard::isKing(type))
+    {
+        m_king_squares[Bitboard::sideIndex(Bitboard::getColor(type))] = square;
+    }
+}
+
+inline void Board::removePiece(int square)
+{
+    const int type = m_mailbox[square];
+
+    if (type == Bitboard::Pieces::e)
+    {
+        return;
+    }
+
+    const Bitboard::U64 bit = Bitboard::squareBit(square);
+
+    m_pieces[Bitboard::pieceIndex(type)] &= ~bit;
+    m_occupancy[Bitboard::sideIndex(Bitboard::getColor(type))] &= ~bit;
+    m_all_occupancy &= ~bit;
+
+    m_mailbox[square] = Bitboard::Pieces::e;
+
+    int &king_square = m_king_squares[Bitboard::sideIndex(Bitboard::getColor(type))];
+
+    if (Bitboard::isKing(type) && king_square == square)
+    {
+        king_square = Bitboard::Squares::no_sq;
+    }
+}
+
+inline Bitboard::U64 Board::attackersTo(int square, Bitboard::U64 occupancy) const noexcept
+{
+    using namespace Bitboard;
+
+    const U64 bishops_queens = pieces(Pieces::B) | pieces(Pieces::b) | pieces(Pieces::Q) | pieces(Pieces::q);
+    const U64 rooks_queens = pieces(Pieces::R) | pieces(Pieces::r) | pieces(Pieces::Q) | pieces(Pieces::q);
+
+    // A pawn of one side attacks the square iff a pawn of the other side
+    // on the square would attack it back.
+    return (Attacks::pawnAttacks(Sides::BLACK, square) & pieces(Pieces::P)) |
+           (Attacks::pawnAttacks(Sides::WHITE, square) & pieces(Pieces::p)) |
+           (Attacks::knightAttacks(square) & (pieces(Pieces::N) | pieces(Pieces::n))) |
+           (Attacks::kingAttacks(square) & (pieces(Pieces::K) | pieces(Pieces::k))) |
+           (Attacks::bishopAttacks(square, occupancy) & bishops_queens) |
+           (Attacks::rookAttacks(square, occupancy) & rooks_queens);
+}
+
+inline bool Board::isSquareAttacked(int square, int by_side) const noexcept
+{
+    using namespace Bitboard;
+
+    const int opponent = by_side ^ 0b11;
+
+    // Test the cheap leaper masks before the slider lookups.
+    if ((Attacks::pawnAttacks(opponent, square) & pieces(pieceOfSide(Pieces::P, by_side))) ||
+        (Attacks::knightAttacks(square) & pieces(pieceOfSide(Pieces::N, by_side))) ||
+        (Attacks::kingAttacks(square) & pieces(pieceOfSide(Pieces::K, by_side))))
+    {
+        return true;
+    }
+
+    const U64 queens = pieces(pieceOfSide(Pieces::Q, by_side));
+
+    return (Attacks::bishopAttacks(square, m_all_occupancy) & (pieces(pieceOfSide(Pieces::B, by_side)) | queens)) ||
+           (Attacks::rookAttacks(square, m_all_occupancy) & (pieces(pieceOfSide(Pieces::R, by_side)) | queens));
+}
+
+// Move a piece to another square, capturing whatever was there.
+inline void Board::movePiece(int old_square, int new_square)
+{
+    const int type = m_mailbox[old_square];
+
+    removePiece(old_square);
+    putPiece(new_square, type);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <memory>
+
+#include "bitboard.hpp"
+#include "board.hpp"
+#include "position.hpp"
+#include "move_list.hpp"
+
+class ZobristHashing;
+class TranspositionTable;
+
+// The state of the engine. Nothing here depends on SDL, so that the engine can
+// be built without the GUI.
+namespace Globals
+{
+    extern std::shared_ptr<ZobristHashing> zobrist_hashing;
+
+    // Shared by every search thread.
+    extern std::shared_ptr<TranspositionTable> transposition_table;
+} // namespace Globals
@@ -5,7 +5,7 @@
 #include <numeric>
 #include <array>
 
-#include "globals.hpp"
+#include "engine_globals.hpp"
 #include "bitboard.hpp"
 #include "move.hpp"
 
@@ -26,7 +26,15 @@ enum MaterialValue : int
 
 namespace Evaluation
 {
-    constexpr int PAWN_CAPTURE_PENALTY = 350;
+    // Scores of the search. Being mated in N plies scores -(MATE_SCORE - N).
+    constexpr int MATE_SCORE = 32000;
+    constexpr int INFINITE_SCORE = MATE_SCORE + 1;
+
+    constexpr int MAX_PLY = 128;
+    constexpr int MATE_IN_MAX_PLY = MATE_SCORE - MAX_PLY;
+
+    // Move ordering penalty of a move that loses material on its target square.
+    constexpr int LOSING_EXCHANGE_PENALTY = 350;
     constexpr int LOSING_CASTLING_RIGHTS_PENALTY = 350;
 
     struct Factors
@@ -44,9 +52,14 @@ namespace Evaluation
         int piece_square_table_black = 0;
     };
 
-    const int evaluateFactors();
+    // Score of the position, relative to the side to move.
+    const int evaluateFactors(Position &position);
 
     const int getPieceValue(const int type);
+
+    // Value of the piece the move captures. En passant captures a pawn that is
+    // not on the target square.
+    int capturedValue(const Board &board, Move move);
     const std::array<int, 64> &getPieceSquareTable(const int type);
 
     int getSquareValue(const int side, int square, const int type);
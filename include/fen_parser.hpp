@@ -6,15 +6,16 @@
 #include <vector>
 #include <sstream>
 #include <iterator>
-#include <windows.h>
 
-#include "globals.hpp"
+#include "engine_globals.hpp"
 #include "singleton.hpp"
 #include "bitboard.hpp"
 
 class FenParser : public Singleton
 {
 public:
+    static constexpr const char *INITIAL_POSITION = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
     [[nodiscard]] inline static FenParser &getInstance()
     {
         if (s_Instance == nullptr)
@@ -25,7 +26,10 @@ public:
         return *s_Instance;
     }
 
-    int init();
+    // Load the FEN string into the position. Returns 0 on success and 1 if a
+    // field is missing, the en passant square is not on the rank behind a pawn
+    // that just moved two squares, or the halfmove clock is not a number.
+    int init(Position &position);
     void load_fen_from_file(const char *path);
     
     void updateFEN();
@@ -34,6 +38,16 @@ public:
         return m_FEN;
     }
 
+    // Replace the FEN string. Call init() afterwards to load the position.
+    void setFEN(const std::string &fen) {
+        m_FEN = fen;
+    }
+
+    // Log the parsed fields to the console. Turn it off when stdout is a protocol.
+    void setVerbose(bool verbose) {
+        m_verbose = verbose;
+    }
+
 protected:
     FenParser();
     ~FenParser();
@@ -41,4 +55,5 @@ protected:
 private:
     static FenParser *s_Instance;
     std::string m_FEN;
+    bool m_verbose = true;
 };
\ No newline at end of file
@@ -10,15 +10,20 @@
 #include "texture.hpp"
 #include "interface.hpp"
 #include "move.hpp"
+#include "attacks.hpp"
 #include "audio_manager.hpp"
 #include "gui/settings.hpp"
 #include "evaluation.hpp"
 #include "fen_parser.hpp"
 #include "minimax_search.hpp"
+#include "perft.hpp"
 
 class Game : public Search
 {
 public:
+  // Depth of the perft test of the position on the screen. (Ctrl + P)
+  static constexpr int PERFT_DEPTH = 4;
+
   Game();
   ~Game();
 
@@ -29,6 +34,10 @@ public:
 
   inline bool isRunning() const { return m_running; }
 
+  // Called every frame. Starts a search when the engine is to move, and plays
+  // the move once the search is done.
+  void playBestMove(const SearchLimits &limits, const unsigned int human_player = 0b10);
+
   void playRandomly();
 
   void resetBoard();
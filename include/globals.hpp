@@ -1,11 +1,11 @@
 #pragma once
 
 #include <SDL2/SDL.h>
-#include "bitboard.hpp"
+#include "engine_globals.hpp"
 #include "audio_manager.hpp"
-#include "zobrist_hashing.hpp"
 #include <memory>
 #include <tuple>
+#include <vector>
 
 constexpr unsigned int FPS = 60;
 constexpr unsigned int FRAME_DELAY = FPS / 1000;
@@ -27,37 +27,11 @@ struct Ply
     SDL_Point move;
 
     bool is_capture{false};
-    int old_piece_in_dest{Bitboard::Squares::no_sq};
-    int moved_piece{Bitboard::Pieces::e};
 
-    bool old_move_bit{false};
-    bool old_move_bit_in_dest{false};
+    // This is used to take back the move.
+    Move legal_move;
 };
 
-struct LegalMove
-{
-    int x{Bitboard::Squares::no_sq};
-    int y{Bitboard::Squares::no_sq};
-
-    bool is_pawn_promotion{false};
-
-    // The pawn will be promoted to a queen by default.
-    int will_promote_to{Bitboard::Pieces::Q};
-
-    int score;
-};
-
-struct PerftData
-{
-    int num_of_positions = 0;
-    int num_of_captures = 0;
-    int num_of_checks = 0;
-    int num_of_en_passant = 0;
-    int num_of_castles = 0;
-    int num_of_promotions = 0;
-};
-
-class ZobristHashing;
 class Interface;
 
 namespace Globals
@@ -71,11 +45,6 @@ namespace Globals
     // Preferences
     extern bool display_legal_move_hints;
 
-    extern int side;
-    extern int en_passant;
-    extern int en_passant_legal_move_index;
-
-    extern int castling;
     extern unsigned int promotion_squares;
 
     extern int selected_square;
@@ -94,23 +63,19 @@ namespace Globals
     extern SDL_Point linear_interpolant;
     extern SDL_Point scaled_linear_interpolant;
 
-    extern std::vector<int> bitboard;
+    // The position on the screen. The search works on copies of it.
+    extern Position position;
 
-    extern std::vector<LegalMove> legal_moves;
-    extern std::vector<LegalMove> move_hints;
+    // Legal moves of the position on the screen.
+    extern MoveList legal_moves;
+    extern MoveList move_hints;
 
     // This is array of LSF for controlled squares.
     extern std::vector<SDL_Point> opponent_occupancy;
 
     extern std::vector<int> opponent_pseudolegal_moves;
-    extern std::vector<int> max_squares;
-    extern std::vector<std::vector<int>> precomputed_max_squares_to_edge;
-    extern std::bitset<64U> move_bitset;
-
-    extern std::vector<std::uint64_t> position_history;
 
     extern std::vector<Ply> ply_array;
-    extern std::vector<std::tuple<int, int, int>> move_squares;
 
     extern std::vector<SDL_Rect> quad_vector;
 
@@ -121,17 +86,11 @@ namespace Globals
 
     extern int square_of_king_in_check;
 
-    extern SDL_Point castling_square;
-
-    // This is useful for the 50-move rule.
-    extern int halfmove_clock;
-
     extern int move_delay;
 
     extern int current_move;
 
     extern std::shared_ptr<AudioManager> audio_manager;
-    extern std::shared_ptr<ZobristHashing> zobrist_hashing;
     extern std::shared_ptr<Interface> interface_handler;
 
     // void createWindow(const char *title, int width, int height);
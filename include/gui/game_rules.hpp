@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+
+#include "globals.hpp"
+#include "move.hpp"
+
+// The rules of the game on the screen. These work on Globals::position and
+// the state of the GUI, so they are not part of the engine library.
+namespace MoveGenerator
+{
+    enum OccupiedSquareMapFlags
+    {
+        PAWN_OCCUPIED_SQUARES_MAP = 1 << 1,
+        KING_OCCUPIED_SQUARES_MAP = 1 << 2,
+        OPPONENT_OCCUPIED_SQUARES_MAP = 1 << 3,
+        PLAYER_TO_MOVE_OCCUPIED_SQUARES_MAP = 1 << 4
+    };
+
+    // Translate squares into the algebraic notation.
+    [[nodiscard]] const std::string toAlgebraicNotation(int type, int old_square, int square,
+                                                        bool is_capture, bool is_a_castling_move, int dx);
+
+    // Check if the square does not contain any pieces.
+    bool notEmpty(const int t_square);
+
+    // Fill Globals::opponent_occupancy with the squares controlled by the opponent,
+    // or by the side to move with PLAYER_TO_MOVE_OCCUPIED_SQUARES_MAP.
+    void searchForOccupiedSquares(int filter = OPPONENT_OCCUPIED_SQUARES_MAP);
+
+    // Generate the legal moves of the position on the screen into Globals::legal_moves.
+    MoveList &generateLegalMoves();
+
+    // Check for possible terminations of the game on the screen.
+    inline const bool noMoreLegalMove();
+
+    const bool isInTerminalCondition();
+    const bool isCheckmate();
+
+    const bool isStalemate();
+}; // namespace MoveGenerator
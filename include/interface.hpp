@@ -6,13 +6,11 @@
 
 #include "globals.hpp"
 #include "move.hpp"
+#include "gui/game_rules.hpp"
 
 enum MoveFlags : int
 {
-    SHOULD_SUPRESS_HINTS = 1 << 0,
-    SHOULD_EXCHANGE_TURN = 1 << 1,
-    WILL_UNDO_MOVE = 1 << 2,
-    IS_CASTLING = 1 << 3
+    SHOULD_SUPRESS_HINTS = 1 << 0
 };
 
 class Interface
@@ -24,7 +22,10 @@ public:
     // This is for the buttons.
     static int AABB(int x, int y);
 
+    // Play the first legal move between the squares. Promotions are to a queen.
     void drop(int square, int old_square, const unsigned int flags);
+    // Play the exact move, including the piece of a promotion.
+    void drop(const Move move, const unsigned int flags);
     void undo();
 
 private:
@@ -1,23 +1,287 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <vector>
+
+#if defined(__MINGW32__) && !defined(_GLIBCXX_HAS_GTHREADS)
+#include "mingw.thread.h"
+#else
+#include <thread>
+#endif
 
-#include "globals.hpp"
+#include "engine_globals.hpp"
 #include "bitboard.hpp"
 #include "move.hpp"
+#include "move_history.hpp"
+#include "move_picker.hpp"
 #include "evaluation.hpp"
-#include "interface.hpp"
+#include "transposition_table.hpp"
+#include "time_manager.hpp"
+
+// Progress of the search, reported after every completed iteration.
+struct SearchInfo
+{
+    int depth = 0;
+
+    // The deepest ply reached by the search.
+    int seldepth = 0;
+
+    // Score of the side to move. See Evaluation::MATE_SCORE for mate scores.
+    int score = 0;
+
+    std::uint64_t nodes = 0;
+
+    // Milliseconds since the search started.
+    std::int64_t time = 0;
+
+    int hashfull = 0;
+
+    // The principal variation, starting with the best move.
+    std::vector<Move> pv;
+};
+
+// Margins of the forward pruning of the nodes near the leaves, where the static
+// evaluation is a good guess of the score. Depths are the remaining depth of the
+// node, and a rule only applies up to its maximum depth.
+struct PruningParameters
+{
+    // A node whose static evaluation beats beta by reverse_futility_margin per
+    // ply of depth returns the evaluation. (Reverse futility pruning) Deeper
+    // nodes have time to find the tactics the static evaluation misses.
+    int reverse_futility_max_depth = 3;
+    int reverse_futility_margin = 120;
+
+    // A node whose static evaluation is below alpha by razoring_base plus
+    // razoring_margin per ply of depth is searched by the quiescence search
+    // only, and returns if that fails low too. (Razoring)
+    int razoring_max_depth = 3;
+    int razoring_base = 300;
+    int razoring_margin = 200;
+
+    // A quiet move that does not give check is skipped if the static evaluation
+    // plus futility_base plus futility_margin per ply of depth can not reach
+    // alpha. (Futility pruning)
+    int futility_max_depth = 3;
+    int futility_base = 100;
+    int futility_margin = 100;
+
+    // The quiet moves after the first late_move_base + depth * depth are
+    // skipped. (Late move pruning)
+    int late_move_max_depth = 6;
+    int late_move_base = 3;
+
+    // A capture is skipped if its static exchange loses more than
+    // see_capture_margin per ply of depth.
+    int see_max_depth = 6;
+    int see_capture_margin = 100;
+};
 
 class Search
 {
 public:
+    // Thinking time of a move played in the GUI, in milliseconds.
+    static constexpr std::int64_t DEFAULT_MOVE_TIME = 1000;
+
+    // The limits are checked once every this many nodes. Must be a power of two.
+    static constexpr std::uint64_t CHECK_INTERVAL = 2048;
+
+    // A capture is skipped by the quiescence search if the static evaluation plus
+    // the value of the captured piece plus this margin can not reach alpha.
+    static constexpr int DELTA_MARGIN = 200;
+
+    // Null-move pruning searches the pass NULL_MOVE_REDUCTION + depth / 6 plies
+    // shallower than the node, from NULL_MOVE_MIN_DEPTH on. From
+    // NULL_MOVE_VERIFICATION_DEPTH on, a cutoff is only trusted once a reduced
+    // search of the node without null moves fails high too.
+    static constexpr int NULL_MOVE_MIN_DEPTH = 3;
+    static constexpr int NULL_MOVE_REDUCTION = 3;
+    static constexpr int NULL_MOVE_VERIFICATION_DEPTH = 10;
+
+    // Late move reductions apply from LMR_MIN_DEPTH on, to the quiet moves after
+    // the first LMR_MIN_MOVES. The reduction of the nth move at a depth is
+    // LMR_BASE + ln(depth) * ln(n) / LMR_DIVISOR, one ply less in PV nodes, for
+    // killers and counter moves and for every LMR_HISTORY_DIVISOR of history.
+    static constexpr int LMR_MIN_DEPTH = 3;
+    static constexpr int LMR_MIN_MOVES = 3;
+    static constexpr double LMR_BASE = 0.75;
+    static constexpr double LMR_DIVISOR = 2.25;
+    static constexpr int LMR_HISTORY_DIVISOR = 8192;
+
+    // Later moves are reduced as much as this one.
+    static constexpr int MAX_REDUCED_MOVES = 64;
+
+    // Half width of the first aspiration window. It doubles on every re-search.
+    static constexpr int ASPIRATION_WINDOW = 50;
+
+    // Helper threads skip some depths, so that the threads do not all search the
+    // same depth at the same time. Helper i searches a depth unless
+    // (depth + SKIP_PHASE[i]) / SKIP_SIZE[i] is odd.
+    static constexpr int NUM_OF_SKIP_PATTERNS = 20;
+    static constexpr int SKIP_SIZE[NUM_OF_SKIP_PATTERNS] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                                            3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+    static constexpr int SKIP_PHASE[NUM_OF_SKIP_PATTERNS] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3,
+                                                             4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
     Search();
     ~Search();
 
-    const std::vector<LegalMove> &moveOrdering(bool only_captures = false);
+    // Generate the legal moves and sort them from the most promising to the least.
+    // The nodes below the root use a MovePicker instead.
+    void moveOrdering(const Position &position, MoveList &moves, const Move tt_move = Move());
+
+    // Search the captures and promotions until the position is quiet, so that
+    // the evaluation is not taken in the middle of an exchange. (Horizon effect)
+    // A side in check searches every evasion instead.
+    [[nodiscard]] int quiescenceSearch(Position &position, int alpha, int beta, int ply);
+    // Principal variation search. Scores are relative to the side to move. The ply
+    // is the distance from the root, used to score mates by their distance.
+    [[nodiscard]] int negamaxSearch(Position &position, int depth, int alpha, int beta, int ply = 0);
+
+    // Search every root move to the given depth and move the best one to the front
+    // of the list. Returns the score of the side to move.
+    int searchRoot(Position &position, MoveList &root_moves, int depth, int alpha, int beta);
+
+    // Search to depth 1, 2, 3... until one of the limits is reached. Every iteration
+    // searches the previous best move first, inside an aspiration window around the
+    // previous score. Returns the best move of the last completed iteration.
+    [[nodiscard]] Move iterativeDeepening(Position &position, int thread_id = 0);
+
+    // Search the position with every thread (Lazy SMP). Every thread searches its
+    // own copy of the position and they share the transposition table. Only the
+    // move of the calling thread is played. It does not clear a stop() that was
+    // requested before it started, so call clearStop() first.
+    [[nodiscard]] Move think(const Position &root, const SearchLimits &limits);
+
+    // Run think() on a copy of the position on a background thread.
+    void startThinking(const Position &position, const SearchLimits &limits);
+
+    [[nodiscard]] inline bool isThinking() const noexcept { return m_is_thinking; }
+
+    // Called by the thread that calls think() after every completed iteration.
+    using InfoCallback = std::function<void(const SearchInfo &)>;
+
+    void setInfoCallback(InfoCallback callback) { m_info_callback = std::move(callback); }
+
+    // The opponent played the expected move. The search keeps going, but the
+    // time limits now apply. It is safe to call this from another thread.
+    void ponderhit() noexcept;
+
+    // A background search has finished and its move was not taken yet.
+    [[nodiscard]] inline bool hasBestMove() const noexcept
+    {
+        return !m_is_thinking && m_search_thread.joinable();
+    }
+
+    // Wait for the background search to finish and return its best move.
+    Move waitForBestMove();
+
+    // Tune the forward pruning of every thread. This must not be changed while
+    // thinking.
+    void setPruningParameters(const PruningParameters &parameters);
+
+    [[nodiscard]] inline const PruningParameters &pruningParameters() const noexcept
+    {
+        return m_pruning;
+    }
+
+    // Forget the move ordering statistics of the previous games, in every
+    // thread. This must not be called while thinking.
+    void clearHistory() noexcept;
+
+    // Abort the running search. It is safe to call this from another thread.
+    void stop() noexcept;
+
+    // Forget the stop of the previous search, in every thread. Call this before
+    // the thread that runs think() is started, so that a stop() sent right
+    // after the search is started is not lost.
+    void clearStop() noexcept;
+
+    // The number of search threads, including the calling thread. This must
+    // not be changed while thinking.
+    void setNumOfThreads(std::size_t num_of_threads);
+
+    [[nodiscard]] inline std::size_t numOfThreads() const noexcept { return m_helpers.size() + 1; }
+
+    // Nodes searched by every thread.
+    [[nodiscard]] std::uint64_t nodes() const noexcept;
+
+    // The part of the nodes that were searched by the quiescence search.
+    [[nodiscard]] std::uint64_t qnodes() const noexcept;
+
+private:
+    // Set the stop flag if the node or the time limit is reached.
+    void checkLimits();
+
+    // The quiet move caused a beta cutoff. The quiet moves searched before it
+    // did not.
+    void updateQuietStats(const Position &position, Move move, const Move *searched_quiets,
+                          int num_of_searched_quiets, int depth, int ply);
+
+    // Search a move that was just made. The first move of a node gets the full
+    // window, the others a null window and a re-search if they beat alpha. A
+    // reduced move is searched at the full depth only once it beats alpha.
+    [[nodiscard]] int searchMove(Position &position, int depth, int alpha, int beta, int ply,
+                                 bool is_first_move, int reduction = 0);
+
+    // The move is the new best move of the ply. Its line is the move followed by
+    // the line of the next ply.
+    void updatePV(int ply, const Move move);
+
+    // Count the node and check the limits every CHECK_INTERVAL nodes.
+    [[nodiscard]] inline bool shouldAbort()
+    {
+        // Only this thread writes the counter. Other threads may read it.
+        const std::uint64_t nodes = m_nodes.load(std::memory_order_relaxed) + 1;
+        m_nodes.store(nodes, std::memory_order_relaxed);
+
+        if ((nodes & (CHECK_INTERVAL - 1)) == 0)
+        {
+            checkLimits();
+        }
+
+        return m_stop.load(std::memory_order_relaxed);
+    }
+
+    SearchLimits m_limits;
+    PruningParameters m_pruning;
+    TimeManager m_time_manager;
+
+    std::atomic<std::uint64_t> m_nodes{0};
+    std::atomic<std::uint64_t> m_qnodes{0};
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_pondering{false};
+
+    // Null moves are not tried before this ply, while a null-move cutoff is
+    // being verified.
+    int m_null_move_min_ply = 0;
+
+    // Only this thread writes the selective depth.
+    int m_seldepth = 0;
+
+    // Quiet move ordering statistics. The history is aged between searches, the
+    // killers are cleared.
+    KillerTable m_killers;
+    HistoryTable m_history;
+    CounterMoveTable m_counter_moves;
+
+    // The move made at every ply of the current line, to find counter moves.
+    std::array<Move, Evaluation::MAX_PLY> m_move_stack;
+
+    // Triangular PV table. The line of a ply is m_pv_table[ply][ply] up to
+    // m_pv_table[ply][m_pv_length[ply] - 1].
+    std::array<std::array<Move, Evaluation::MAX_PLY>, Evaluation::MAX_PLY> m_pv_table;
+    std::array<int, Evaluation::MAX_PLY + 1> m_pv_length{};
+
+    InfoCallback m_info_callback;
 
-    [[nodiscard]] const int quiescenceSearch(int alpha, int beta);
-    [[nodiscard]] int minimaxSearch(int depth, int alpha, int beta, bool is_maximizing);
-    
-    void playBestMove(int depth, const unsigned int human_player = 0b10);
+    std::vector<std::unique_ptr<Search>> m_helpers;
 
-    void playRandomly();
+    std::thread m_search_thread;
+    std::atomic<bool> m_is_thinking{false};
+    Move m_best_move;
 };
\ No newline at end of file
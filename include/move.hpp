@@ -3,139 +3,103 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <functional>
 #include <cmath>
 #include <array>
 #include <string>
 #include <utility>
 #include <numeric>
 
-#include "globals.hpp"
-
-struct ImaginaryMove
-{
-    int old_piece = Bitboard::Squares::no_sq;
-    int captured_piece = Bitboard::Squares::no_sq;
-    bool old_move_bit = false;
-    bool old_move_bit_of_dest = false;
-
-    bool is_castling = false;
-    bool is_en_passant = false;
-
-    int en_passant_capture_square = Bitboard::Squares::no_sq;
-    int en_passant_capture_piece_type = Bitboard::Pieces::e;
-
-    int team = Bitboard::Sides::WHITE;
-    int old_half_move_clock = 0;
-};
+#include "engine_globals.hpp"
 
 namespace MoveGenerator
 {
-    const std::vector<int> OFFSETS = {
-        // Rook (R, L, B, T)
-        1, -1, 8, -8,
-        // Bishop (SE, SW, NE, NW)
-        9, 7, -7, -9,
-        // Knights (North)
-        -17, -15, -10, -6,
-        // South
-        17, 15, 10, 6};
+    // The fifty-move rule, in plies.
+    constexpr int HALFMOVE_CLOCK_THRESHOLD = 100;
 
-    constexpr int KNIGHT_OFFSET_START = 8;
-    constexpr int KNIGHT_OFFSET_END = 16;
-
-    constexpr int HALFMOVE_CLOCK_THRESHOLD = 50;
-
-    enum OccupiedSquareMapFlags
+    // Kind of moves to generate. Every kind only yields legal moves.
+    enum GenType
     {
-        PAWN_OCCUPIED_SQUARES_MAP = 1 << 1,
-        KING_OCCUPIED_SQUARES_MAP = 1 << 2,
-        OPPONENT_OCCUPIED_SQUARES_MAP = 1 << 3,
-        PLAYER_TO_MOVE_OCCUPIED_SQUARES_MAP = 1 << 4
+        // Captures and promotions, including en passant.
+        CAPTURES,
+        // Moves that neither capture nor promote, including castling.
+        QUIETS,
+        // Every move of a side in check.
+        EVASIONS,
+        // Every move of a side that is not in check.
+        NON_EVASIONS,
+        // EVASIONS or NON_EVASIONS, whichever applies to the position.
+        LEGAL
     };
 
-    // Add the square in the legal move array
-    void
-    addMove(const int t_square, const int old_square) noexcept;
-
-    // Set the square as an "occupied square"
-    void addOccupancySquare(const int t_square, const int old_square) noexcept;
-
-    // Only render the possible moves of the selected piece.
-    void renderMove(const int t_square, const int old_square) noexcept;
-
-    // Get the distance between the delta square and the target square.
-    int getMaxDeltaSquares(const int delta_square, const int square_prime);
-
-    // Make an imaginary move and update the bitboard temporarily.
-    const ImaginaryMove makeMove(const LegalMove &move);
-
-    // Unmake the imaginary move and restore the old bitboard data.
-    void unmakeMove(const LegalMove &move, const ImaginaryMove &data);
-
-    // Translate squares into the algebraic notation.
-    [[nodiscard]] const std::string toAlgebraicNotation(int type, int old_square, int square,
-                                                        bool is_capture, bool is_a_castling_move, int dx);
-
-    // TODO: Implement pawn underpromotion as a "legal move".
-    void pawnPromotion(const int t_square);
-
-    // Check if the square does not contain any pieces.
-    bool notEmpty(const int t_square);
-
-    // Check if we can capture the square.
-    bool canCapture(const int t_square, const bool for_occupied_square = false);
-
-    // En Passant implementation.
-    void enPassant(const int t_square, const std::function<void(int, int)> moveFunc);
-
-    void generatePawnCaptures(int t_square, const std::function<void(int, int)> moveFunc, bool for_occupied_squares);
-
-    const std::vector<int> &getDistToEdge(const SDL_Point pos);
-
-    void precomputeMaxSquaresToEdge();
-
-    void generatePawnMoves(const int t_square, const int team, std::function<void(int, int)> moveFunc);
-
-    void generateSlidingMoves(int t_square, std::function<void(int, int)> moveFunc, bool for_occupied_square);
-
-    // This is used to check for pieces within the home rank from the king or queen side.
-    void isFlankEmpty(int flank, int t_square, std::function<void(int, int)> moveFunc);
-
-    // Check if castling is legal or not.
-    void generateCastlingMove(int t_square, std::function<void(int, int)> moveFunc);
-
-    void generateKnightMoves(int t_square, std::function<void(int, int)> moveFunc, bool for_occupied_squares);
-
-    // Exclude moves that can put the king in check.
-    void generateKingMoves(int t_square, std::function<void(int, int)> moveFunc, bool for_occupied_squares);
-
-    // Render pseudo-legal move hints.
-    // TODO: Refactor the pawn moves.
-    // TODO: Replace the boolean arguments with an unsigned int flag.
-    // TODO: Update pawn promotions.
-    void searchPseudoLegalMoves(const int t_square, std::function<void(int, int)> moveFunc,
-                                bool for_occupied_squares = false, bool for_legal_moves = false, bool only_captures = false);
-
-    void searchForOccupiedSquares(int filter = OPPONENT_OCCUPIED_SQUARES_MAP);
-
-    // Scan the whole bitboard to find the king.
-    const int getOwnKing();
-
-    const bool isInCheck();
-
-    void filterPseudoLegalMoves(std::vector<LegalMove> &hint_square_array, bool only_captures = false);
-
-    std::vector<LegalMove> &generateLegalMoves(const bool only_captures = false);
-
-    // Check for possible terminations.
-    inline const bool noMoreLegalMove();
+    // Call visit(square, attacks) for each of the pieces of the side. The king of
+    // the other side does not block the sliders, so it can not step back along the
+    // ray of a piece that gives check.
+    template <int Side, typename Visitor>
+    inline void forEachAttack(const Board &board, Bitboard::U64 pieces, Visitor &&visit)
+    {
+        const Bitboard::U64 blockers =
+            board.occupancy() & ~board.pieces(Bitboard::pieceOfSide(Bitboard::Pieces::K, Side ^ 0b11));
+
+        pieces &= board.occupancy(Side);
+
+        while (pieces)
+        {
+            const int square = Bitboard::popLSB(pieces);
+            const int type = board.pieceAt(square);
+
+            if (Bitboard::isPawn(type))
+            {
+                visit(square, Attacks::pawnAttacks(Side, square));
+            }
+            else if (Bitboard::isKnight(type))
+            {
+                visit(square, Attacks::knightAttacks(square));
+            }
+            else if (Bitboard::isKing(type))
+            {
+                visit(square, Attacks::kingAttacks(square));
+            }
+            else
+            {
+                visit(square, Attacks::sliderAttacks(type, square, blockers));
+            }
+        }
+    }
+
+    template <typename Visitor>
+    inline void forEachAttack(const Board &board, int side, Bitboard::U64 pieces, Visitor &&visit)
+    {
+        if (side & Bitboard::Sides::WHITE)
+        {
+            forEachAttack<Bitboard::Sides::WHITE>(board, pieces, std::forward<Visitor>(visit));
+        }
+        else
+        {
+            forEachAttack<Bitboard::Sides::BLACK>(board, pieces, std::forward<Visitor>(visit));
+        }
+    }
+
+    // Squares attacked by the given pieces of a side.
+    Bitboard::U64 generateAttacks(const Board &board, const int side, const Bitboard::U64 pieces);
+
+    // Total number of squares attacked by each piece of a side.
+    int countAttacks(const Board &board, const int side);
+
+    // Generate only legal moves. Checkers, pins and the squares that resolve a check
+    // are computed once, so no move has to be made and unmade to test its legality.
+    // The generators are specialized for the side to move and the type of moves.
+    template <GenType Type>
+    void generateMoves(const Position &position, MoveList &moves);
+
+    inline void generateLegalMoves(const Position &position, MoveList &moves)
+    {
+        generateMoves<LEGAL>(position, moves);
+    }
 
-    const bool isInTerminalCondition();
-    const bool isCheckmate();
+    // Long algebraic notation, like e2e4 or e7e8q. The null move is 0000.
+    [[nodiscard]] std::string toUCINotation(Move move);
 
-    const bool isStalemate();
-    const bool isInsufficientMaterial();
-    const bool isThreefoldRepetition();
-    const bool isFiftyMoveRule();
+    // The legal move of the position written in long algebraic notation, or
+    // the null move if there is none.
+    [[nodiscard]] Move fromUCINotation(const Position &position, const std::string &notation);
 }; // namespace MoveGenerator
\ No newline at end of file
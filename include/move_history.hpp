@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
+#include "bitboard.hpp"
+#include "board.hpp"
+#include "evaluation.hpp"
+#include "move_list.hpp"
+
+// Statistics of the quiet moves that caused beta cutoffs, used to order the
+// quiet moves of later nodes. Every search thread has its own tables, so they
+// are never shared or locked.
+
+// Two quiet moves per ply that caused a beta cutoff. A sibling node often has
+// the same refutation.
+class KillerTable
+{
+public:
+    using Killers = std::array<Move, 2>;
+
+    KillerTable() { clear(); }
+
+    void clear() noexcept { m_killers.fill(Killers{}); }
+
+    [[nodiscard]] inline const Killers &at(int ply) const noexcept { return m_killers[ply]; }
+
+    // The newest killer is tried first. The older one takes the second slot.
+    inline void store(int ply, Move move) noexcept
+    {
+        Killers &killers = m_killers[ply];
+
+        if (killers[0] != move)
+        {
+            killers[1] = killers[0];
+            killers[0] = move;
+        }
+    }
+
+private:
+    std::array<Killers, Evaluation::MAX_PLY> m_killers;
+};
+
+// The score of every quiet move by side, origin and target square. (Butterfly
+// board) Moves that caused cutoffs gain, the moves searched before them lose.
+class HistoryTable
+{
+public:
+    // The scores stay within [-MAX_SCORE, MAX_SCORE].
+    static constexpr int MAX_SCORE = 16384;
+    static constexpr int MAX_BONUS = 1200;
+
+    HistoryTable() { clear(); }
+
+    void clear() noexcept { m_scores.fill({}); }
+
+    [[nodiscard]] inline int score(int side, Move move) const noexcept
+    {
+        return m_scores[Bitboard::sideIndex(side)][move.from()][move.to()];
+    }
+
+    // Move the score by the bonus, by less the closer it already is to the
+    // limit on that side. (Gravity) A deep cutoff counts more than a shallow one.
+    inline void update(int side, Move move, int bonus) noexcept
+    {
+        std::int16_t &score = m_scores[Bitboard::sideIndex(side)][move.from()][move.to()];
+        score += bonus - score * std::abs(bonus) / MAX_SCORE;
+    }
+
+    [[nodiscard]] static inline int bonus(int depth) noexcept
+    {
+        return std::min(depth * depth, MAX_BONUS);
+    }
+
+    // Halve every score, so that the statistics of a previous search still help
+    // without outweighing the ones of the current position.
+    void age() noexcept
+    {
+        for (auto &side_scores : m_scores)
+        {
+            for (auto &from_scores : side_scores)
+            {
+                for (std::int16_t &score : from_scores)
+                {
+                    score /= 2;
+                }
+            }
+        }
+    }
+
+private:
+    std::array<std::array<std::array<std::int16_t, Bitboard::NUM_OF_SQUARES>, Bitboard::NUM_OF_SQUARES>, 2> m_scores;
+};
+
+// The quiet move that last refuted a move, by the piece that moved and its target
+// square.
+class CounterMoveTable
+{
+public:
+    CounterMoveTable() { clear(); }
+
+    void clear() noexcept { m_moves.fill({}); }
+
+    // The board is the board after the previous move.
+    [[nodiscard]] inline Move at(const Board &board, Move previous_move) const noexcept
+    {
+        return m_moves[board.pieceAt(previous_move.to())][previous_move.to()];
+    }
+
+    inline void store(const Board &board, Move previous_move, Move move) noexcept
+    {
+        m_moves[board.pieceAt(previous_move.to())][previous_move.to()] = move;
+    }
+
+private:
+    std::array<std::array<Move, Bitboard::NUM_OF_SQUARES>, Bitboard::NUM_OF_PIECE_TYPES + 1> m_moves;
+};
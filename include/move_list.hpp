@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "bitboard.hpp"
+
+// A move packed into 16 bits.
+//
+// Bits 0-5   -> Target square
+// Bits 6-11  -> Origin square
+// Bits 12-13 -> Promotion piece (Q, B, N or R, relative to Bitboard::Pieces::Q)
+// Bits 14-15 -> Flag
+class Move
+{
+public:
+    enum Flag : std::uint16_t
+    {
+        NORMAL = 0 << 14,
+        PROMOTION = 1 << 14,
+        EN_PASSANT = 2 << 14,
+        CASTLING = 3 << 14
+    };
+
+    constexpr Move() noexcept = default;
+
+    constexpr Move(int from, int to, Flag flag = NORMAL, int promotion_type = Bitboard::Pieces::Q) noexcept
+        : m_data(static_cast<std::uint16_t>(to | (from << 6) | ((promotion_type - Bitboard::Pieces::Q) << 12) | flag))
+    {
+    }
+
+    [[nodiscard]] constexpr int to() const noexcept { return m_data & 0x3F; }
+    [[nodiscard]] constexpr int from() const noexcept { return (m_data >> 6) & 0x3F; }
+
+    [[nodiscard]] constexpr Flag flag() const noexcept { return static_cast<Flag>(m_data & (3 << 14)); }
+
+    [[nodiscard]] constexpr bool isPromotion() const noexcept { return flag() == PROMOTION; }
+
+    // The white piece type the pawn is promoted to. Use Bitboard::pieceOfSide()
+    // to get the piece of the side to move.
+    [[nodiscard]] constexpr int promotionType() const noexcept
+    {
+        return Bitboard::Pieces::Q + ((m_data >> 12) & 0b11);
+    }
+
+    // The null move (a1 to a1) is never a legal move.
+    [[nodiscard]] constexpr bool isNull() const noexcept { return m_data == 0; }
+
+    [[nodiscard]] constexpr std::uint16_t raw() const noexcept { return m_data; }
+
+    [[nodiscard]] static constexpr Move fromRaw(std::uint16_t raw) noexcept
+    {
+        Move move;
+        move.m_data = raw;
+        return move;
+    }
+
+    constexpr bool operator==(const Move &other) const noexcept { return m_data == other.m_data; }
+    constexpr bool operator!=(const Move &other) const noexcept { return m_data != other.m_data; }
+
+private:
+    std::uint16_t m_data = 0;
+};
+
+// Fixed-capacity move list. It lives on the stack of the caller, so generating
+// moves never allocates. Each move has a score used for move ordering.
+class MoveList
+{
+public:
+    // No legal chess position has more than 218 moves.
+    static constexpr std::size_t MAX_MOVES = 256;
+
+    inline void push(Move move) noexcept
+    {
+        m_scores[m_size] = 0;
+        m_moves[m_size++] = move;
+    }
+
+    inline void clear() noexcept { m_size = 0; }
+
+    [[nodiscard]] inline std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] inline bool empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] inline Move &operator[](std::size_t index) noexcept { return m_moves[index]; }
+    [[nodiscard]] inline const Move &operator[](std::size_t index) const noexcept { return m_moves[index]; }
+
+    [[nodiscard]] inline int &score(std::size_t index) noexcept { return m_scores[index]; }
+    [[nodiscard]] inline int score(std::size_t index) const noexcept { return m_scores[index]; }
+
+    [[nodiscard]] inline Move *begin() noexcept { return m_moves.data(); }
+    [[nodiscard]] inline Move *end() noexcept { return m_moves.data() + m_size; }
+    [[nodiscard]] inline const Move *begin() const noexcept { return m_moves.data(); }
+    [[nodiscard]] inline const Move *end() const noexcept { return m_moves.data() + m_size; }
+
+    // Swap the move with the highest score in [index, size()) into the index and
+    // return it. (Selection sort, one step at a time)
+    Move pickBest(std::size_t index) noexcept
+    {
+        std::size_t best = index;
+
+        for (std::size_t i = index + 1; i < m_size; ++i)
+        {
+            if (m_scores[i] > m_scores[best])
+            {
+                best = i;
+            }
+        }
+
+        std::swap(m_moves[index], m_moves[best]);
+        std::swap(m_scores[index], m_scores[best]);
+
+        return m_moves[index];
+    }
+
+    // Sort the moves by descending score. Insertion sort is stable and fast
+    // for lists of this size.
+    void sortByScore() noexcept
+    {
+        for (std::size_t i = 1; i < m_size; ++i)
+        {
+            const Move move = m_moves[i];
+            const int score = m_scores[i];
+
+            std::size_t j = i;
+
+            for (; j > 0 && m_scores[j - 1] < score; --j)
+            {
+                m_moves[j] = m_moves[j - 1];
+                m_scores[j] = m_scores[j - 1];
+            }
+
+            m_moves[j] = move;
+            m_scores[j] = score;
+        }
+    }
+
+private:
+    std::array<Move, MAX_MOVES> m_moves;
+    std::array<int, MAX_MOVES> m_scores;
+    std::size_t m_size = 0;
+};
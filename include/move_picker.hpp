@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "move.hpp"
+#include "move_history.hpp"
+
+// Yields the legal moves of a position one at a time, from the most promising
+// to the least. The moves are generated and scored in stages, and every call
+// only selects the best remaining move of its stage, so a node that cuts off
+// after a few moves never pays for the moves it does not search.
+class MovePicker
+{
+public:
+    // For the main search: the move of the transposition table, the captures
+    // that do not lose material, the killers and the counter move, the other
+    // quiet moves by history, then the captures that lose material. A side in
+    // check gets the move of the table, then the other evasions.
+    MovePicker(const Position &position, Move tt_move, const KillerTable::Killers &killers,
+               Move counter_move, const HistoryTable &history);
+
+    // For the quiescence search: the captures and promotions, most valuable
+    // victim first. A side in check gets every evasion.
+    explicit MovePicker(const Position &position);
+
+    // The next move, or the null move once every move was yielded.
+    [[nodiscard]] Move next();
+
+    // Yield no more quiet moves. The captures that lose material still follow.
+    inline void skipQuiets() noexcept { m_skip_quiets = true; }
+
+private:
+    enum Stage
+    {
+        MAIN_TT,
+        CAPTURES_INIT,
+        GOOD_CAPTURES,
+        REFUTATIONS,
+        QUIETS_INIT,
+        QUIETS,
+        BAD_CAPTURES,
+
+        EVASIONS_TT,
+        EVASIONS_INIT,
+        EVASIONS,
+
+        QSEARCH_INIT,
+        QSEARCH_CAPTURES,
+
+        DONE
+    };
+
+    // Whether the move of the table is legal in the position. It is looked up
+    // in the list of its kind, which is generated early for that.
+    [[nodiscard]] bool isLegalTTMove();
+
+    // Whether the move is a legal quiet move that was not yielded yet.
+    [[nodiscard]] bool isNewRefutation(std::size_t index);
+
+    [[nodiscard]] bool isRefutation(Move move) const noexcept;
+
+    void scoreCaptures(MoveList &moves) const;
+    void scoreQuiets(MoveList &moves) const;
+
+    const Position &m_position;
+    const Move m_tt_move;
+
+    // The killers, then the counter move.
+    std::array<Move, 3> m_refutations;
+
+    // Null for the quiescence search.
+    const HistoryTable *m_history = nullptr;
+
+    Stage m_stage;
+
+    // The evasions of a side in check are kept with the captures.
+    MoveList m_captures;
+    MoveList m_quiets;
+
+    bool m_skip_quiets = false;
+
+    bool m_captures_generated = false;
+    bool m_quiets_generated = false;
+
+    std::size_t m_index = 0;
+
+    // The captures that lose material are moved to the front of m_captures,
+    // in the order they are found, and searched last.
+    std::size_t m_num_of_bad_captures = 0;
+};
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <iostream>
 
 // Non-copyable mixin
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "engine_globals.hpp"
+#include "move.hpp"
+
+// Leaf positions of a perft run, broken down by the move that reached them.
+struct PerftData
+{
+    std::uint64_t num_of_positions = 0;
+    std::uint64_t num_of_captures = 0;
+    std::uint64_t num_of_checks = 0;
+    std::uint64_t num_of_en_passant = 0;
+    std::uint64_t num_of_castles = 0;
+    std::uint64_t num_of_promotions = 0;
+
+    PerftData &operator+=(const PerftData &other) noexcept
+    {
+        num_of_positions += other.num_of_positions;
+        num_of_captures += other.num_of_captures;
+        num_of_checks += other.num_of_checks;
+        num_of_en_passant += other.num_of_en_passant;
+        num_of_castles += other.num_of_castles;
+        num_of_promotions += other.num_of_promotions;
+        return *this;
+    }
+};
+
+// Node counts of subtrees, keyed by the Zobrist hash and the depth. Like the
+// transposition table, a slot stores its key XOR'd with its data, so that the
+// perft threads can share it without a lock.
+class PerftHashTable
+{
+public:
+    explicit PerftHashTable(std::size_t size_mb);
+
+    [[nodiscard]] bool probe(std::uint64_t key, int depth, std::uint64_t &nodes) const noexcept;
+    void store(std::uint64_t key, int depth, std::uint64_t nodes) noexcept;
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> key{0};
+        std::atomic<std::uint64_t> data{0};
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_mask = 0;
+};
+
+// Count the leaves of the move tree to a fixed depth. The counts are compared
+// with known values to test the move generator, and the speed measures it.
+namespace Perft
+{
+    struct Options
+    {
+        int depth = 1;
+        std::size_t num_of_threads = 1;
+
+        // Size of the PerftHashTable. Zero disables it.
+        std::size_t hash_mb = 0;
+
+        // Fill the PerftData breakdown. Every leaf is made, so bulk counting and
+        // the hash table are not used.
+        bool collect_stats = false;
+    };
+
+    struct Result
+    {
+        std::uint64_t nodes = 0;
+        PerftData data;
+
+        // Leaves below each root move, in the order of generation. (divide)
+        std::vector<std::pair<Move, std::uint64_t>> divide;
+
+        // Milliseconds.
+        std::int64_t time = 0;
+    };
+
+    // The moves of the last ply are counted, not made. (Bulk counting)
+    std::uint64_t count(Position &position, int depth, PerftHashTable *hash_table = nullptr);
+
+    // Make every move down to the leaves and classify the moves of the last ply.
+    void collect(Position &position, int depth, PerftData &data);
+
+    // Run perft on the position. The threads take the root moves one by one.
+    [[nodiscard]] Result run(const Position &position, const Options &options);
+
+    // Print the divide, the breakdown if it was collected, and the speed.
+    void print(const Result &result, const Options &options, std::ostream &out = std::cout);
+} // namespace Perft
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "bitboard.hpp"
+#include "board.hpp"
+#include "move_list.hpp"
+
+// The state of a position that can not be recovered when a move is undone.
+// Every move pushes a new one on the stack of the position.
+struct StateInfo
+{
+    std::uint64_t key = 0;
+
+    // Castling rights. Use Bitboard::Castle shifted by 2 for white.
+    int castling = 0;
+    int en_passant = Bitboard::Squares::no_sq;
+
+    // Plies since the last capture or pawn move, for the fifty-move rule.
+    int halfmove_clock = 0;
+
+    // Plies since the position was set or the last null move. No position
+    // before a pass can repeat after it.
+    int plies_from_null = 0;
+
+    // The piece captured by the move that led to this state.
+    int captured_piece = Bitboard::Pieces::e;
+};
+
+// A chess position: the board, the side to move and a stack of StateInfo, one
+// per move made since the position was set. A position can be copied, so that
+// every search thread can make moves on its own copy.
+class Position
+{
+public:
+    // The stack is reserved for this many moves, so that a search never grows it.
+    static constexpr std::size_t STATE_STACK_RESERVE = 512;
+
+    Position();
+
+    // Replace the position and clear the move stack.
+    void set(const Board &board, int side, int castling, int en_passant, int halfmove_clock);
+
+    // Remove a piece from the board, outside of a move. (Board editing)
+    void removePiece(int square);
+
+    void doMove(Move move);
+    void undoMove(Move move);
+
+    // Pass the turn to the opponent.
+    void doNullMove();
+    void undoNullMove();
+
+    [[nodiscard]] inline const Board &board() const noexcept { return m_board; }
+    [[nodiscard]] inline int side() const noexcept { return m_side; }
+
+    [[nodiscard]] inline const StateInfo &state() const noexcept { return m_states.back(); }
+
+    [[nodiscard]] inline std::uint64_t key() const noexcept { return state().key; }
+    [[nodiscard]] inline int castling() const noexcept { return state().castling; }
+    [[nodiscard]] inline int enPassant() const noexcept { return state().en_passant; }
+    [[nodiscard]] inline int halfmoveClock() const noexcept { return state().halfmove_clock; }
+
+    // Number of moves made since the position was set.
+    [[nodiscard]] inline int gamePly() const noexcept { return static_cast<int>(m_states.size()) - 1; }
+
+    // Square of the king of the side to move, or Bitboard::Squares::no_sq.
+    [[nodiscard]] inline int kingSquare() const noexcept { return m_board.kingSquare(m_side); }
+
+    [[nodiscard]] bool isInCheck() const noexcept;
+
+    // Pieces of the opponent that give check to the king of the side to move.
+    [[nodiscard]] Bitboard::U64 checkers() const noexcept;
+
+    // Pieces of the side to move that are pinned to their own king.
+    [[nodiscard]] Bitboard::U64 pinnedPieces() const noexcept;
+
+    // Whether the legal move checks the king of the opponent, directly or by
+    // uncovering a slider, without making it.
+    [[nodiscard]] bool givesCheck(Move move) const noexcept;
+
+    // Static exchange evaluation. Whether the material balance of the captures
+    // on the target square of the move is at least the threshold, when both
+    // sides always capture with their least valuable piece and may stop at any
+    // time. Pins are ignored.
+    [[nodiscard]] bool see(Move move, int threshold = 0) const noexcept;
+
+    // Whether the move neither captures nor promotes, like the moves generated
+    // by MoveGenerator::QUIETS.
+    [[nodiscard]] inline bool isQuiet(Move move) const noexcept
+    {
+        return move.flag() != Move::EN_PASSANT && !move.isPromotion() && m_board.isEmpty(move.to());
+    }
+
+    // Whether the side to move has a piece other than its king and pawns. Without
+    // one, passing is often the best move. (Zugzwang)
+    [[nodiscard]] inline bool hasNonPawnMaterial() const noexcept
+    {
+        using namespace Bitboard;
+
+        return m_board.occupancy(m_side) & ~m_board.pieces(pieceOfSide(Pieces::P, m_side)) &
+               ~m_board.pieces(pieceOfSide(Pieces::K, m_side));
+    }
+
+    [[nodiscard]] bool isInsufficientMaterial() const noexcept;
+    [[nodiscard]] bool isThreefoldRepetition() const noexcept;
+    [[nodiscard]] bool isFiftyMoveRule() const noexcept;
+
+    // Hash the position from scratch. Moves update the key incrementally.
+    [[nodiscard]] std::uint64_t computeKey() const;
+
+private:
+    Board m_board;
+    int m_side = Bitboard::Sides::WHITE;
+
+    std::vector<StateInfo> m_states;
+};
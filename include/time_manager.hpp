@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Limits of a single search. A value of zero means that there is no limit.
+struct SearchLimits
+{
+    // Remaining clock time and increment of the side to move, in milliseconds.
+    std::int64_t time = 0;
+    std::int64_t increment = 0;
+
+    // Number of moves until the next time control. Zero for sudden death.
+    int moves_to_go = 0;
+
+    // Fixed time of this move, in milliseconds.
+    std::int64_t move_time = 0;
+
+    std::uint64_t max_nodes = 0;
+    int max_depth = 0;
+
+    // Search until the search is stopped, ignoring the time limits.
+    bool infinite = false;
+
+    // Search on the time of the opponent. The time limits only apply once the
+    // opponent plays the expected move. (ponderhit)
+    bool ponder = false;
+};
+
+// Allocates the time of a move from the search limits.
+//
+// The search should not start a new iteration after the optimum time, since
+// it would most likely be unable to finish it. The maximum time is a hard limit
+// that aborts the search.
+class TimeManager
+{
+public:
+    // Number of moves the remaining time is divided into when the time control
+    // does not say otherwise.
+    static constexpr int DEFAULT_MOVES_TO_GO = 30;
+
+    // Time kept in reserve for the delay between the engine and the GUI.
+    static constexpr std::int64_t MOVE_OVERHEAD = 30;
+
+    // Start the clock of a new search.
+    void init(const SearchLimits &limits);
+
+    // Milliseconds since init() was called.
+    [[nodiscard]] inline std::int64_t elapsed() const
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - m_start_time)
+            .count();
+    }
+
+    [[nodiscard]] inline bool isTimeLimited() const noexcept { return m_is_time_limited; }
+
+    [[nodiscard]] inline std::int64_t optimumTime() const noexcept { return m_optimum_time; }
+    [[nodiscard]] inline std::int64_t maximumTime() const noexcept { return m_maximum_time; }
+
+private:
+    std::chrono::steady_clock::time_point m_start_time;
+
+    bool m_is_time_limited = false;
+
+    std::int64_t m_optimum_time = 0;
+    std::int64_t m_maximum_time = 0;
+};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "move_list.hpp"
+#include "evaluation.hpp"
+
+// Shared hash table of searched positions, keyed by the Zobrist hash.
+//
+// Every slot stores the key XOR'd with its data. A reader recomputes the key from
+// both words, so a slot that is torn by a concurrent write simply fails to match
+// and no lock is needed when several search threads share the table.
+class TranspositionTable
+{
+public:
+    enum Bound : std::uint8_t
+    {
+        BOUND_NONE = 0,
+        // The score is at most the stored score. (Fail-low)
+        BOUND_UPPER = 1,
+        // The score is at least the stored score. (Fail-high)
+        BOUND_LOWER = 2,
+        BOUND_EXACT = BOUND_UPPER | BOUND_LOWER
+    };
+
+    // The decoded data of a slot.
+    struct Entry
+    {
+        Move move;
+        int score = 0;
+        int depth = 0;
+        Bound bound = BOUND_NONE;
+    };
+
+    // Only counted when built with TT_STATS. Every thread updates the same
+    // counters, so they would contend on one cache line under Lazy SMP.
+    struct Stats
+    {
+        std::uint64_t probes = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t stores = 0;
+
+        // Stores that overwrote the entry of another position.
+        std::uint64_t collisions = 0;
+    };
+
+    static constexpr std::size_t DEFAULT_SIZE_MB = 16;
+
+    explicit TranspositionTable(std::size_t size_mb = DEFAULT_SIZE_MB);
+    ~TranspositionTable();
+
+    // Reallocate the table with the largest power-of-two number of buckets
+    // that fits in the given size. This also clears the table.
+    void resize(std::size_t size_mb);
+    void clear();
+
+    // Age the entries of the previous searches so they are replaced first.
+    void newSearch() noexcept;
+
+    [[nodiscard]] bool probe(std::uint64_t key, Entry &entry) const noexcept;
+
+    // The score must already be adjusted with scoreToTT().
+    void store(std::uint64_t key, int depth, int score, Bound bound, Move move) noexcept;
+
+    // Permille of the sampled slots that were written by the current search.
+    [[nodiscard]] int hashfull() const noexcept;
+
+    [[nodiscard]] Stats stats() const noexcept;
+    void resetStats() noexcept;
+
+    [[nodiscard]] inline std::size_t sizeInMB() const noexcept { return m_size_mb; }
+
+    // Mate scores are stored relative to the node instead of the root, so that
+    // the entry is valid wherever the position is reached in the tree.
+    [[nodiscard]] static inline int scoreToTT(int score, int ply) noexcept
+    {
+        if (score >= Evaluation::MATE_IN_MAX_PLY)
+        {
+            return score + ply;
+        }
+
+        if (score <= -Evaluation::MATE_IN_MAX_PLY)
+        {
+            return score - ply;
+        }
+
+        return score;
+    }
+
+    [[nodiscard]] static inline int scoreFromTT(int score, int ply) noexcept
+    {
+        if (score >= Evaluation::MATE_IN_MAX_PLY)
+        {
+            return score - ply;
+        }
+
+        if (score <= -Evaluation::MATE_IN_MAX_PLY)
+        {
+            return score + ply;
+        }
+
+        return score;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> key{0};
+        std::atomic<std::uint64_t> data{0};
+    };
+
+    static constexpr std::size_t BUCKET_SIZE = 4;
+
+    // Four slots fill a single cache line.
+    struct alignas(64) Bucket
+    {
+        Slot slots[BUCKET_SIZE];
+    };
+
+    [[nodiscard]] inline Bucket &bucketOf(std::uint64_t key) const noexcept
+    {
+        return m_buckets[key & m_mask];
+    }
+
+    std::unique_ptr<Bucket[]> m_buckets;
+    std::size_t m_mask = 0;
+    std::size_t m_size_mb = 0;
+
+    std::uint8_t m_generation = 0;
+
+#if defined(TT_STATS)
+    mutable std::atomic<std::uint64_t> m_probes{0};
+    mutable std::atomic<std::uint64_t> m_hits{0};
+    std::atomic<std::uint64_t> m_stores{0};
+    std::atomic<std::uint64_t> m_collisions{0};
+#endif
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "engine_globals.hpp"
+#include "minimax_search.hpp"
+#include "non_copyable.hpp"
+
+// The Universal Chess Interface. Reads the commands of a GUI or a match runner
+// from stdin and answers on stdout. The search runs on its own thread, so that
+// "stop" and "ponderhit" are handled while the engine is thinking.
+class UCI : public NonCopyable
+{
+public:
+    static constexpr const char *ENGINE_NAME = "NeuralChess";
+    static constexpr const char *ENGINE_AUTHOR = "BlueProgrammer212";
+
+    static constexpr int MAX_HASH_MB = 4096;
+    static constexpr int MAX_THREADS = 256;
+
+    UCI();
+    ~UCI();
+
+    // Handle the commands until "quit" or the end of the input.
+    void loop(std::istream &input = std::cin);
+
+    // Handle a single command. Returns false on "quit".
+    bool execute(const std::string &command);
+
+    // "cp <centipawns>" or "mate <moves>", negative if the engine is mated.
+    [[nodiscard]] static std::string scoreToUCI(int score);
+
+private:
+    void uci();
+    void setOption(std::istringstream &stream);
+    void setPosition(std::istringstream &stream);
+    void go(std::istringstream &stream);
+
+    // Not part of the protocol. "bench [depth]" prints the node signature.
+    void bench(std::istringstream &stream);
+
+    void reportInfo(const SearchInfo &info);
+
+    // Abort the running search and wait for its "bestmove".
+    void stopSearch();
+
+    // Write a line. The search thread writes concurrently with the main thread.
+    void send(const std::string &line);
+
+    Position m_position;
+    Search m_search;
+
+    std::thread m_search_thread;
+    std::mutex m_output_mutex;
+
+    // The principal variation of the last completed iteration. Only the search
+    // thread uses it while thinking.
+    std::vector<Move> m_pv;
+};
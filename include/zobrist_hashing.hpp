@@ -1,10 +1,12 @@
 #pragma once
 
-#include "globals.hpp"
+#include "engine_globals.hpp"
 #include <random>
 #include <array>
 
-using ZobristTable = std::vector<std::vector<unsigned long long>>;
+// Random keys of every piece on every square, indexed by square then by
+// Bitboard::pieceIndex().
+using ZobristTable = std::array<std::array<std::uint64_t, Bitboard::NUM_OF_PIECE_TYPES>, Bitboard::NUM_OF_SQUARES>;
 
 class ZobristHashing
 {
@@ -12,17 +14,38 @@ public:
     ZobristHashing();
     ~ZobristHashing();
 
-    // Generate the seed.
+    // Generate the keys. The seed is fixed so that the keys are the same on every run.
     void init();
 
-    const std::uint64_t hashPosition();
-
     const ZobristTable& getZobristTable() const; 
 
+    [[nodiscard]] inline std::uint64_t pieceKey(int type, int square) const noexcept
+    {
+        return m_zobrist_table[square][Bitboard::pieceIndex(type)];
+    }
+
+    // XOR'd in when black is to move.
+    [[nodiscard]] inline std::uint64_t sideKey() const noexcept { return m_side_key; }
+
+    // Castling rights are a 4-bit mask, so every combination has its own key.
+    [[nodiscard]] inline std::uint64_t castlingKey(int castling) const noexcept
+    {
+        return m_castling_keys[castling & 0b1111];
+    }
+
+    // Only the file of the en passant square is hashed.
+    [[nodiscard]] inline std::uint64_t enPassantKey(int square) const noexcept
+    {
+        return m_en_passant_keys[square & Bitboard::BOARD_SIZE];
+    }
+
 private:
     ZobristTable m_zobrist_table;
 
-    std::random_device m_random_device;
+    std::uint64_t m_side_key;
+    std::array<std::uint64_t, 16> m_castling_keys;
+    std::array<std::uint64_t, Bitboard::BOARD_SIZE + 1> m_en_passant_keys;
+
     std::mt19937_64 m_random_number_generator;
     std::uniform_int_distribution<unsigned long long> distribution;
-};
\ No newline at end of file
+};
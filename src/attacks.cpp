@@ -0,0 +1,225 @@
+#include "attacks.hpp"
+
+namespace Attacks {
+
+std::array<Magic, Bitboard::NUM_OF_SQUARES> bishop_magics;
+std::array<Magic, Bitboard::NUM_OF_SQUARES> rook_magics;
+
+std::array<Bitboard::U64, Bitboard::NUM_OF_SQUARES> knight_attacks;
+std::array<Bitboard::U64, Bitboard::NUM_OF_SQUARES> king_attacks;
+std::array<std::array<Bitboard::U64, Bitboard::NUM_OF_SQUARES>, 2> pawn_attacks;
+
+std::array<std::array<Bitboard::U64, Bitboard::NUM_OF_SQUARES>, Bitboard::NUM_OF_SQUARES>
+    between_squares;
+std::array<std::array<Bitboard::U64, Bitboard::NUM_OF_SQUARES>, Bitboard::NUM_OF_SQUARES>
+    line_squares;
+
+namespace {
+
+//Total number of blocker configurations of every square.
+constexpr std::size_t ROOK_TABLE_SIZE = 0x19000;
+constexpr std::size_t BISHOP_TABLE_SIZE = 0x1480;
+
+//The largest blocker mask (a rook on a corner) has 12 relevant squares.
+constexpr std::size_t MAX_BLOCKER_CONFIGURATIONS = 1 << 12;
+
+std::array<Bitboard::U64, ROOK_TABLE_SIZE> rook_table;
+std::array<Bitboard::U64, BISHOP_TABLE_SIZE> bishop_table;
+
+//{file, rank} increments of each sliding direction.
+constexpr int ROOK_DIRECTIONS[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+constexpr int BISHOP_DIRECTIONS[4][2] = {{1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+
+constexpr int KNIGHT_JUMPS[8][2] = {{1, 2},  {2, 1},  {2, -1}, {1, -2},
+                                    {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+constexpr int KING_STEPS[8][2] = {{1, 0},  {-1, 0}, {0, 1},  {0, -1},
+                                  {1, 1},  {-1, 1}, {1, -1}, {-1, -1}};
+
+//White pawns advance towards the 0th rank of the mailbox.
+constexpr int WHITE_PAWN_CAPTURES[2][2] = {{-1, -1}, {1, -1}};
+constexpr int BLACK_PAWN_CAPTURES[2][2] = {{-1, 1}, {1, 1}};
+
+constexpr Bitboard::U64 FIRST_RANK = 0xFFULL;
+constexpr Bitboard::U64 FIRST_FILE = 0x0101010101010101ULL;
+
+//xorshift64* generator. The seed is fixed so that the same magics are
+//found on every startup.
+class MagicRNG {
+ public:
+  explicit MagicRNG(std::uint64_t seed) : m_state(seed) {}
+
+  std::uint64_t next() {
+    m_state ^= m_state >> 12;
+    m_state ^= m_state << 25;
+    m_state ^= m_state >> 27;
+    return m_state * 2685821657736338717ULL;
+  }
+
+  //Magic candidates with only a few bits set are far more likely to work.
+  std::uint64_t sparse() { return next() & next() & next(); }
+
+ private:
+  std::uint64_t m_state;
+};
+
+//Walk every ray until the edge of the board or the first blocker.
+Bitboard::U64 slidingAttacks(const int (&directions)[4][2], int square,
+                             Bitboard::U64 occupancy) {
+  Bitboard::U64 attacks = Bitboard::EMPTY_BITBOARD;
+
+  for (const auto& direction : directions) {
+    int file = (square & Bitboard::BOARD_SIZE) + direction[0];
+    int rank = (square >> 3) + direction[1];
+
+    while (file >= 0 && file <= Bitboard::BOARD_SIZE && rank >= 0 &&
+           rank <= Bitboard::BOARD_SIZE) {
+      const int target_square = Bitboard::toSquareIndex(file, rank);
+      attacks |= Bitboard::squareBit(target_square);
+
+      if (occupancy & Bitboard::squareBit(target_square)) {
+        break;
+      }
+
+      file += direction[0];
+      rank += direction[1];
+    }
+  }
+
+  return attacks;
+}
+
+//Squares reached by a single step of each offset, ignoring the offsets
+//that leave the board.
+template <std::size_t N>
+Bitboard::U64 leaperAttacks(const int (&steps)[N][2], int square) {
+  Bitboard::U64 attacks = Bitboard::EMPTY_BITBOARD;
+
+  for (const auto& step : steps) {
+    const int file = (square & Bitboard::BOARD_SIZE) + step[0];
+    const int rank = (square >> 3) + step[1];
+
+    if (file >= 0 && file <= Bitboard::BOARD_SIZE && rank >= 0 && rank <= Bitboard::BOARD_SIZE) {
+      attacks |= Bitboard::squareBit(Bitboard::toSquareIndex(file, rank));
+    }
+  }
+
+  return attacks;
+}
+
+void initMagics(const int (&directions)[4][2], Bitboard::U64* table,
+                std::array<Magic, Bitboard::NUM_OF_SQUARES>& magics) {
+  std::array<Bitboard::U64, MAX_BLOCKER_CONFIGURATIONS> occupancies;
+  std::array<Bitboard::U64, MAX_BLOCKER_CONFIGURATIONS> references;
+
+#if !defined(USE_PEXT)
+  //The epoch of a table entry tells whether it was written by the current
+  //magic candidate, which avoids clearing the table after each failure.
+  std::array<int, MAX_BLOCKER_CONFIGURATIONS> epoch{};
+  int attempt = 0;
+
+  MagicRNG rng(0x9E3779B97F4A7C15ULL);
+#endif
+
+  std::size_t size = 0;
+
+  for (int square = 0; square < Bitboard::NUM_OF_SQUARES; ++square) {
+    const Bitboard::U64 rank_mask = FIRST_RANK << ((square >> 3) << 3);
+    const Bitboard::U64 file_mask = FIRST_FILE << (square & Bitboard::BOARD_SIZE);
+
+    //Pieces on the edge of the board never block a ray.
+    const Bitboard::U64 edges =
+        ((FIRST_RANK | (FIRST_RANK << 56)) & ~rank_mask) |
+        ((FIRST_FILE | (FIRST_FILE << Bitboard::BOARD_SIZE)) & ~file_mask);
+
+    Magic& magic = magics[square];
+
+    magic.mask = slidingAttacks(directions, square, Bitboard::EMPTY_BITBOARD) & ~edges;
+    magic.shift = Bitboard::NUM_OF_SQUARES - Bitboard::popCount(magic.mask);
+    magic.attacks = (square == 0 ? table : magics[square - 1].attacks + size);
+
+    //Enumerate every subset of the mask with the Carry-Rippler trick.
+    Bitboard::U64 blockers = Bitboard::EMPTY_BITBOARD;
+    size = 0;
+
+    do {
+      occupancies[size] = blockers;
+      references[size] = slidingAttacks(directions, square, blockers);
+
+#if defined(USE_PEXT)
+      magic.attacks[magic.index(blockers)] = references[size];
+#endif
+
+      ++size;
+      blockers = (blockers - magic.mask) & magic.mask;
+    } while (blockers);
+
+#if !defined(USE_PEXT)
+    //Try random magics until every blocker configuration maps to a slot
+    //that holds its own attack set.
+    for (std::size_t i = 0; i < size;) {
+      for (magic.magic = 0; Bitboard::popCount((magic.magic * magic.mask) >> 56) < 6;) {
+        magic.magic = rng.sparse();
+      }
+
+      for (++attempt, i = 0; i < size; ++i) {
+        const unsigned int index = magic.index(occupancies[i]);
+
+        if (epoch[index] < attempt) {
+          epoch[index] = attempt;
+          magic.attacks[index] = references[i];
+        } else if (magic.attacks[index] != references[i]) {
+          break;
+        }
+      }
+    }
+#endif
+  }
+}
+
+}  // namespace
+
+void init() {
+  for (int square = 0; square < Bitboard::NUM_OF_SQUARES; ++square) {
+    knight_attacks[square] = leaperAttacks(KNIGHT_JUMPS, square);
+    king_attacks[square] = leaperAttacks(KING_STEPS, square);
+
+    pawn_attacks[Bitboard::sideIndex(Bitboard::Sides::WHITE)][square] =
+        leaperAttacks(WHITE_PAWN_CAPTURES, square);
+    pawn_attacks[Bitboard::sideIndex(Bitboard::Sides::BLACK)][square] =
+        leaperAttacks(BLACK_PAWN_CAPTURES, square);
+  }
+
+  initMagics(ROOK_DIRECTIONS, rook_table.data(), rook_magics);
+  initMagics(BISHOP_DIRECTIONS, bishop_table.data(), bishop_magics);
+
+  //The rays of a slider on either square connect the two squares if they
+  //are aligned.
+  for (int square_a = 0; square_a < Bitboard::NUM_OF_SQUARES; ++square_a) {
+    for (int square_b = 0; square_b < Bitboard::NUM_OF_SQUARES; ++square_b) {
+      const Bitboard::U64 bit_a = Bitboard::squareBit(square_a);
+      const Bitboard::U64 bit_b = Bitboard::squareBit(square_b);
+
+      between_squares[square_a][square_b] = Bitboard::EMPTY_BITBOARD;
+      line_squares[square_a][square_b] = Bitboard::EMPTY_BITBOARD;
+
+      if (square_a == square_b) {
+        continue;
+      }
+
+      if (rookAttacks(square_a, Bitboard::EMPTY_BITBOARD) & bit_b) {
+        between_squares[square_a][square_b] = rookAttacks(square_a, bit_b) & rookAttacks(square_b, bit_a);
+        line_squares[square_a][square_b] =
+            (rookAttacks(square_a, Bitboard::EMPTY_BITBOARD) &
+             rookAttacks(square_b, Bitboard::EMPTY_BITBOARD)) | bit_a | bit_b;
+      } else if (bishopAttacks(square_a, Bitboard::EMPTY_BITBOARD) & bit_b) {
+        between_squares[square_a][square_b] =
+            bishopAttacks(square_a, bit_b) & bishopAttacks(square_b, bit_a);
+        line_squares[square_a][square_b] =
+            (bishopAttacks(square_a, Bitboard::EMPTY_BITBOARD) &
+             bishopAttacks(square_b, Bitboard::EMPTY_BITBOARD)) | bit_a | bit_b;
+      }
+    }
+  }
+}
+
+}  // namespace Attacks
@@ -0,0 +1,16 @@
+#include "board.hpp"
+
+Board::Board() {
+  clear();
+}
+
+Board::~Board() {}
+
+void Board::clear() {
+  m_pieces.fill(Bitboard::EMPTY_BITBOARD);
+  m_occupancy.fill(Bitboard::EMPTY_BITBOARD);
+  m_all_occupancy = Bitboard::EMPTY_BITBOARD;
+
+  m_mailbox.fill(Bitboard::Pieces::e);
+  m_king_squares.fill(Bitboard::Squares::no_sq);
+}
@@ -0,0 +1,8 @@
+#include "engine_globals.hpp"
+#include "zobrist_hashing.hpp"
+#include "transposition_table.hpp"
+
+namespace Globals {
+std::shared_ptr<ZobristHashing> zobrist_hashing = std::make_shared<ZobristHashing>();
+std::shared_ptr<TranspositionTable> transposition_table = std::make_shared<TranspositionTable>();
+}  // namespace Globals
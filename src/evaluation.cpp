@@ -15,6 +15,14 @@ const int getPieceValue(const int type) {
   // clang-format on
 }
 
+int capturedValue(const Board& board, Move move) {
+  if (move.flag() == Move::EN_PASSANT) {
+    return getPieceValue(Bitboard::Pieces::P);
+  }
+
+  return getPieceValue(board.pieceAt(move.to()));
+}
+
 const std::array<int, Bitboard::NUM_OF_SQUARES>& getPieceSquareTable(int type) {
   //Get the bonus of the square.
   return PIECE_SQUARE_TABLES[(type - 1) % 6];
@@ -32,7 +40,7 @@ int getSquareValue(const int side, int square, const int type) {
   return square_bonus;
 }
 
-const int evaluateFactors() {
+const int evaluateFactors(Position& position) {
   // clang-format off
   
   auto [
@@ -51,16 +59,19 @@ const int evaluateFactors() {
 
   // clang-format on
 
-  const int rank_increment = Globals::side & Bitboard::Sides::WHITE ? -1 : 1;
+  const Board& board = position.board();
+  const int side = position.side();
+
+  const int rank_increment = side & Bitboard::Sides::WHITE ? -1 : 1;
+
+  Bitboard::U64 occupied_squares = board.occupancy();
 
   //Material evaluation.
-  for (int square = 0; square < Bitboard::NUM_OF_SQUARES; ++square) {
-    const int type = Globals::bitboard[square];
-    const int color = Bitboard::getColor(type);
+  while (occupied_squares) {
+    const int square = Bitboard::popLSB(occupied_squares);
 
-    if (!MoveGenerator::notEmpty(square)) {
-      continue;
-    }
+    const int type = board.pieceAt(square);
+    const int color = Bitboard::getColor(type);
 
     if (!Bitboard::isKing(type)) {
       material_white += (color & 0b10) * getPieceValue(type);
@@ -68,15 +79,15 @@ const int evaluateFactors() {
     }
 
     //Check if a pawn resides in a same file. (Doubled pawn structure)
-    if (Bitboard::isPawn(Globals::bitboard[square]) &&
-        Bitboard::isPawn(Globals::bitboard[(rank_increment << 3) + square])) {
+    if (Bitboard::isPawn(board.pieceAt(square)) &&
+        Bitboard::isPawn(board.pieceAt((rank_increment << 3) + square))) {
       doubled_pawn_structure_white -= (color & 0b10) * 50;
       doubled_pawn_structure_black -= (~color & 0b10) * 50;
     }
 
     //Blocked pawns
-    if (Bitboard::isPawn(Globals::bitboard[square]) &&
-        ~(color & Bitboard::getColor(Globals::bitboard[(rank_increment << 3) + square]))) {
+    if (Bitboard::isPawn(board.pieceAt(square)) &&
+        ~(color & Bitboard::getColor(board.pieceAt((rank_increment << 3) + square)))) {
       blocked_pawns_white -= (color & 0b10) * 50;
       blocked_pawns_black -= (~color & 0b10) * 50;
     }
@@ -87,29 +98,21 @@ const int evaluateFactors() {
   }
 
   //Evaluate the score of how much control squares there are.
-  MoveGenerator::searchForOccupiedSquares(
-      MoveGenerator::OccupiedSquareMapFlags::PLAYER_TO_MOVE_OCCUPIED_SQUARES_MAP);
-
-  //Evaluate control squares.
-  const int spatialAdvantage = static_cast<int>(Globals::opponent_occupancy.size());
-
-  MoveGenerator::searchForOccupiedSquares(
-      MoveGenerator::OccupiedSquareMapFlags::OPPONENT_OCCUPIED_SQUARES_MAP);
-
-  const int spatialDisadvantage = static_cast<int>(Globals::opponent_occupancy.size());
-
-  Globals::side ^= 0b11;
+  const int spatialAdvantage = MoveGenerator::countAttacks(board, side);
+  const int spatialDisadvantage = MoveGenerator::countAttacks(board, side ^ 0b11);
 
   //Make sure every pieces are active and prevent trapped pieces if possible.
-  MoveGenerator::generateLegalMoves();
+  MoveList moves;
 
-  const int mobilityDisadvantage = static_cast<int>(Globals::legal_moves.size());
+  position.doNullMove();
+  MoveGenerator::generateLegalMoves(position, moves);
+  position.undoNullMove();
 
-  Globals::side ^= 0b11;
+  const int mobilityDisadvantage = static_cast<int>(moves.size());
 
-  MoveGenerator::generateLegalMoves();
+  MoveGenerator::generateLegalMoves(position, moves);
 
-  const int mobilityAdvantage = static_cast<int>(Globals::legal_moves.size());
+  const int mobilityAdvantage = static_cast<int>(moves.size());
 
   //Evaluate mobility, material, and spatial advantage.
   const int mobility_evaluation = mobilityAdvantage - mobilityDisadvantage;
@@ -121,7 +124,7 @@ const int evaluateFactors() {
 
   const int central_control_eval = (piece_square_table_white - piece_square_table_black);
 
-  const int perspective = Globals::side & Bitboard::Sides::WHITE ? 1 : -1;
+  const int perspective = side & Bitboard::Sides::WHITE ? 1 : -1;
 
   return (material_evaluation + (10 * mobility_evaluation) + (10 * spatial_evaluation) +
          pawn_structure_eval + central_control_eval) * perspective;
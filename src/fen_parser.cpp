@@ -1,46 +1,73 @@
 #include "fen_parser.hpp"
+#include "attacks.hpp"
+
+#include <charconv>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
 
 FenParser* FenParser::s_Instance = nullptr;
 
-constexpr const char* INITIAL_POSITION = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 constexpr const char* BACK_RANK_MATE = "1k6/ppp5/8/8/8/8/6R1/8 w KQKq - 0 1";
 
 FenParser::FenParser() : m_FEN(INITIAL_POSITION) {}
 
 FenParser::~FenParser() {}
 
-int FenParser::init() {
-  auto coord = SDL_Point{0, 0};
+int FenParser::init(Position& position) {
+  auto coord = Bitboard::Coord{0, 0};
 
   std::string ascii_pieces = ".KQBNRPkqbnrp";
 
-  for (int i = 0; i < 64; ++i) {
-    Globals::bitboard[i] = Bitboard::Pieces::e;
-  };
+  Board board;
 
   std::stringstream ss(m_FEN);
   std::istream_iterator<std::string> begin(ss);
   std::istream_iterator<std::string> end;
   std::vector<std::string> fields(begin, end);
 
-  HANDLE h_console = GetStdHandle(STD_OUTPUT_HANDLE);
+  //The clocks are optional, but the other fields are not.
+  if (fields.size() < 4) {
+    return 1;
+  }
+
+  //The clocks default to the start of the game.
+  fields.resize(6);
+
+  if (fields[4].empty()) {
+    fields[4] = "0";
+  }
 
-  SetConsoleTextAttribute(h_console, 1);
-  std::cout << "[INFO] ";
-  SetConsoleTextAttribute(h_console, 15);
-  std::cout << "Parsing the FEN string.\n";
+  if (fields[5].empty()) {
+    fields[5] = "1";
+  }
 
   bool is_white_to_move = fields[1] == "w";
 
-  //Log every information in the console.
-  std::cout << "--------FEN INFORMATION--------\n"
-            << "FEN string: " << fields[0] << "\n"
-            << "White to move: " << (is_white_to_move ? "Yes" : "No") << "\n"
-            << "Castling Rights: " << fields[2] << "\n"
-            << "En Passant square: " << fields[3] << "\n"
-            << "Halfmove Clock: " << fields[4] << "\n"
-            << "Fullmove Clock: " << fields[5] << "\n"
-            << "-------------------------------\n";
+  if (m_verbose) {
+    //The console is only colored on Windows.
+#if defined(_WIN32)
+    HANDLE h_console = GetStdHandle(STD_OUTPUT_HANDLE);
+
+    SetConsoleTextAttribute(h_console, 1);
+    std::cout << "[INFO] ";
+    SetConsoleTextAttribute(h_console, 15);
+#else
+    std::cout << "[INFO] ";
+#endif
+    std::cout << "Parsing the FEN string.\n";
+
+    //Log every information in the console.
+    std::cout << "--------FEN INFORMATION--------\n"
+              << "FEN string: " << fields[0] << "\n"
+              << "White to move: " << (is_white_to_move ? "Yes" : "No") << "\n"
+              << "Castling Rights: " << fields[2] << "\n"
+              << "En Passant square: " << fields[3] << "\n"
+              << "Halfmove Clock: " << fields[4] << "\n"
+              << "Fullmove Clock: " << fields[5] << "\n"
+              << "-------------------------------\n";
+  }
 
   //Loop over the FEN string.
   for (const char symbol : fields[0]) {
@@ -64,20 +91,61 @@ int FenParser::init() {
 
     if (piece_type != std::string::npos) {
       int square = Bitboard::toSquareIndex(coord.x, coord.y);
-      Globals::bitboard[square] = piece_type;
+      board.putPiece(square, static_cast<int>(piece_type));
       coord.x++;
       continue;
     }
   }
 
-  Globals::side |= Bitboard::Sides::WHITE;
+  const int side = is_white_to_move ? Bitboard::Sides::WHITE : Bitboard::Sides::BLACK;
+
+  //Black's castling rights are in the first two bits, white's in the next two.
+  int castling = 0;
 
-  if (!is_white_to_move) {
-    Globals::side ^= 0b11;
+  for (const char symbol : fields[2]) {
+    const int flank = std::tolower(symbol) == 'k' ? Bitboard::Castle::SHORT_CASTLE
+                    : std::tolower(symbol) == 'q' ? Bitboard::Castle::LONG_CASTLE
+                                                   : 0;
+
+    castling |= flank << (std::isupper(symbol) ? Bitboard::Sides::WHITE : 0);
   }
 
-  //TODO: Update the castling rights in the flag.
-  
+  int en_passant = Bitboard::Squares::no_sq;
+
+  if (fields[3] != "-") {
+    //The square behind a pawn that just moved two squares: rank 6 when white
+    //is to move and rank 3 when black is.
+    const char en_passant_rank = is_white_to_move ? '6' : '3';
+
+    if (fields[3].size() != 2 || fields[3][0] < 'a' || fields[3][0] > 'h' ||
+        fields[3][1] != en_passant_rank) {
+      return 1;
+    }
+
+    const int file = fields[3][0] - 'a';
+    const int rank = '8' - fields[3][1];
+
+    const int square = Bitboard::toSquareIndex(file, rank);
+    const int pawn = Bitboard::pieceOfSide(Bitboard::Pieces::P, side);
+
+    //Like Position::doMove, only keep the square if a pawn can capture on it,
+    //so that the key is the same as after the moves that reach the position.
+    if (Attacks::pawnAttacks(side ^ 0b11, square) & board.pieces(pawn)) {
+      en_passant = square;
+    }
+  }
+
+  //The halfmove clock counts the plies since the last capture or pawn move.
+  int halfmove_clock = 0;
+
+  const char* clock_end = fields[4].data() + fields[4].size();
+  const auto [parsed_end, error] = std::from_chars(fields[4].data(), clock_end, halfmove_clock);
+
+  if (error != std::errc() || parsed_end != clock_end || halfmove_clock < 0) {
+    return 1;
+  }
+
+  position.set(board, side, castling, en_passant, halfmove_clock);
 
   return 0;
 }
@@ -87,28 +87,25 @@ void Game::init(const int width, const int height) {
     }
   }
 
-  MoveGenerator::precomputeMaxSquaresToEdge();
+  //Precalculate the sliding piece attack tables.
+  Attacks::init();
 
-  //By default, it's white to move.
-  side |= Bitboard::WHITE;
-
-  //Initialize the bitboard using the FEN parser.
-  m_fen_parser.init();
+  //Initialize the position using the FEN parser.
+  m_fen_parser.init(position);
 
   MoveGenerator::searchForOccupiedSquares();
 
-  is_in_check = MoveGenerator::isInCheck();
+  is_in_check = position.isInCheck();
 
   //Update the legal move array.
   MoveGenerator::generateLegalMoves();
 
   if (is_in_check) {
     audio_manager->PlayWAV("../../res/check.wav");
-    square_of_king_in_check = MoveGenerator::getOwnKing();
+    square_of_king_in_check = position.kingSquare();
   }
 
   //Settings::init();
-  MoveGenerator::renderMove(-1, -1);
 }
 
 void Game::update() {
@@ -134,12 +131,12 @@ void Game::render() {
 
   //Render the legal moves. (For debugging purposes.)
   if (show_legal_moves) {
-    for (LegalMove square : Globals::legal_moves) {
-      const auto& pos = Bitboard::squareToCoord(square.x);
+    for (const Move move : Globals::legal_moves) {
+      const auto& pos = Bitboard::squareToCoord(move.to());
 
       const SDL_Rect dest = {pos.x * BOX_WIDTH, pos.y * BOX_HEIGHT, BOX_WIDTH, BOX_WIDTH};
 
-      SDL_SetRenderDrawColor(renderer, 75 * square.y, 255, 125, 125);
+      SDL_SetRenderDrawColor(renderer, 75 * move.from(), 255, 125, 125);
       SDL_RenderFillRect(renderer, &dest);
     }
   }
@@ -178,12 +175,8 @@ void Game::render() {
 
   //Render hints.
   if (display_legal_move_hints) {
-    for (const LegalMove& hint : move_hints) {
-      if (hint.x & Bitboard::Squares::no_sq) {
-        continue;
-      }
-
-      const auto& pos = Bitboard::squareToCoord(hint.x);
+    for (const Move hint : move_hints) {
+      const auto& pos = Bitboard::squareToCoord(hint.to());
 
       const SDL_Rect dest = {pos.x * BOX_WIDTH, pos.y * BOX_HEIGHT, BOX_WIDTH, BOX_WIDTH};
 
@@ -216,12 +209,12 @@ void Game::render() {
   }
 
   //Render the pieces.
-  for (int i = 0; i < static_cast<int>(bitboard.size()); i++) {
-    TextureManager::AnimatePiece(i, bitboard[i]);
+  for (int i = 0; i < Bitboard::NUM_OF_SQUARES; i++) {
+    TextureManager::AnimatePiece(i, position.board().pieceAt(i));
   }
 
   if (!(Globals::selected_square & Bitboard::no_sq) && Globals::is_mouse_down) {
-    TextureManager::DrawPiece(bitboard[selected_square]);
+    TextureManager::DrawPiece(position.board().pieceAt(selected_square));
   }
 
   //Render the evaluation bar.
@@ -277,28 +270,23 @@ void Game::render() {
 void Game::resetBoard() {
   std::cout << "\n\nRestoring initial position... Please wait\n\n";
 
-  move_bitset.reset();
   opponent_occupancy.clear();
 
   //Clear the moves recorded from the previous game.
   ply_array.clear();
-  move_squares.clear();
   move_hints.clear();
 
-  position_history.clear();
-
   //Reset every data.
   is_in_check = false;
 
   square_of_king_in_check = Bitboard::Squares::no_sq;
 
-  side = 0;
   move_delay = 0;
   time = 0;
 
-  m_fen_parser.init();
+  m_fen_parser.init(position);
 
-  is_in_check = MoveGenerator::isInCheck();
+  is_in_check = position.isInCheck();
 
   //Update the legal move array.
   MoveGenerator::generateLegalMoves();
@@ -307,7 +295,7 @@ void Game::resetBoard() {
 
   if (is_in_check) {
     audio_manager->PlayWAV("../../res/check.wav");
-    square_of_king_in_check = MoveGenerator::getOwnKing();
+    square_of_king_in_check = position.kingSquare();
   }
 
   //Clear all the bits and add the OPENING flag on restart.
@@ -355,18 +343,23 @@ void Game::events(bool is_ai_computing) {
 
         new_square = Interface::AABB(event.button.y, event.button.x);
 
-        if (selected_square == Bitboard::no_sq && Globals::bitboard[new_square] != Bitboard::e) {
+        if (selected_square == Bitboard::no_sq && position.board().pieceAt(new_square) != Bitboard::e) {
           //If there is no selected square, then allow the selection.
           selected_square = (Bitboard::SHOULD_FLIP ? new_square ^ 0x38 : new_square);
           //is_mouse_down = true;
 
-          MoveGenerator::filterPseudoLegalMoves(Globals::move_hints);
+          //Show the legal moves of the selected piece.
+          for (const Move move : Globals::legal_moves) {
+            if (move.from() == selected_square) {
+              Globals::move_hints.push(move);
+            }
+          }
 
           break;
         }
 
         //If there is a selected square, then drop it to the new square.
-        Globals::interface_handler->drop(new_square, selected_square, SHOULD_EXCHANGE_TURN);
+        Globals::interface_handler->drop(new_square, selected_square, 0);
 
         //If it's not checkmate yet or draw.
         // if (game_state & GameState::OPENING) {
@@ -385,7 +378,7 @@ void Game::events(bool is_ai_computing) {
         }
 
         new_square = Interface::AABB(event.button.y, event.button.x);
-        Globals::interface_handler->drop(new_square, selected_square, SHOULD_EXCHANGE_TURN);
+        Globals::interface_handler->drop(new_square, selected_square, 0);
 
         Globals::move_hints.clear();
         Globals::selected_square = Bitboard::no_sq;
@@ -395,16 +388,16 @@ void Game::events(bool is_ai_computing) {
         break;
       case SDL_KEYDOWN:
         if (event.key.keysym.sym == SDLK_r && selected_square != Bitboard::Squares::no_sq) {
-          Globals::bitboard[selected_square] = Bitboard::e;
+          position.removePiece(selected_square);
 
-          is_in_check = MoveGenerator::isInCheck();
+          is_in_check = position.isInCheck();
 
           //Update the legal move array.
           MoveGenerator::generateLegalMoves();
 
           if (is_in_check) {
             audio_manager->PlayWAV("../../res/check.wav");
-            square_of_king_in_check = MoveGenerator::getOwnKing();
+            square_of_king_in_check = position.kingSquare();
           }
 
           if (MoveGenerator::isCheckmate()) {
@@ -432,9 +425,12 @@ void Game::events(bool is_ai_computing) {
 
             SDL_SetWindowSize(Globals::window, 600 + (show_eval * 25), 600);
           } else if (event.key.keysym.sym == SDLK_p && !is_ai_computing) {
-            is_ai_computing = true;
-            playBestMove(2, 0U);
-            is_ai_computing = false;
+            Perft::Options options;
+            options.depth = PERFT_DEPTH;
+            options.num_of_threads = numOfThreads();
+            options.collect_stats = true;
+
+            Perft::print(Perft::run(position, options), options);
           }
         }
 
@@ -449,4 +445,65 @@ void Game::events(bool is_ai_computing) {
         break;
     }
   }
-}
\ No newline at end of file
+}
+
+void Game::playBestMove(const SearchLimits& limits, const unsigned int human_player) {
+  if (isThinking()) {
+    return;
+  }
+
+  //The search has finished. Play its move on the board of the GUI.
+  if (hasBestMove()) {
+    const Move best_move = waitForBestMove();
+
+    Globals::interface_handler->drop(best_move, SHOULD_SUPRESS_HINTS);
+
+    Globals::move_delay = 0;
+
+    SDL_SetWindowTitle(Globals::window, "NeuralChess");
+    return;
+  }
+
+  if (Globals::position.side() & human_player) {
+    return;
+  }
+
+  Globals::move_delay++;
+
+  if (Globals::move_delay < 3 || MoveGenerator::isInTerminalCondition()) {
+    return;
+  }
+
+  SDL_SetWindowTitle(Globals::window, "NeuralChess [Thinking...]");
+
+  startThinking(Globals::position, limits);
+}
+
+void Game::playRandomly() {
+  if (Globals::position.side() & Bitboard::Sides::WHITE) {
+    return;
+  }
+
+  Globals::move_delay++;
+
+  if (Globals::move_delay >= 30) {
+    MoveGenerator::generateLegalMoves();
+
+    const MoveList& moves = Globals::legal_moves;
+
+    Move random_move = moves[rand() % static_cast<int>(moves.size())];
+
+    //En passant is forced.
+    auto en_passant_move = std::find_if(moves.begin(), moves.end(), [](const Move move) {
+      return move.flag() == Move::EN_PASSANT;
+    });
+
+    if (en_passant_move != moves.end()) {
+      random_move = *en_passant_move;
+    }
+
+    Globals::interface_handler->drop(random_move, SHOULD_SUPRESS_HINTS);
+
+    Globals::move_delay = 0;
+  }
+}
@@ -0,0 +1,148 @@
+#include "gui/game_rules.hpp"
+
+namespace MoveGenerator {
+
+//This is useful to translate the square index into algebraic notation.
+//TODO: Consider using a struct to increase code readability.
+[[nodiscard]] const std::string toAlgebraicNotation(int type, int old_square, int square,
+                                                    bool is_capture, bool is_a_castling_move,
+                                                    int dx) {
+  static int current_ply_index = 0;
+
+  const std::string file_string = "abcdefgh";
+  const std::string rank_string = "87654321";
+  const std::string ascii_pieces = ".KQBNR kqbnr ";
+
+  const Bitboard::Coord coord = Bitboard::squareToCoord(square);
+
+  std::string algebraic_notation;
+
+  //Note: The sides are flipped.
+  if (Globals::position.side() & Bitboard::Sides::BLACK) {
+    std::string ply_index_str = std::to_string(++current_ply_index);
+
+    if (current_ply_index > 1) {
+      algebraic_notation += " ";
+    }
+
+    algebraic_notation += ply_index_str;
+    algebraic_notation += ". ";
+  }
+
+  if (is_a_castling_move) {
+    algebraic_notation += (dx < 0 ? "O-O-O" : "O-O");
+
+    if (Globals::is_in_check) {
+      algebraic_notation += "+";
+    }
+
+    algebraic_notation += " ";
+
+    return algebraic_notation;
+  }
+
+  if (!Bitboard::isPawn(type)) {
+    algebraic_notation += std::toupper(ascii_pieces[type]);
+  }
+
+  //If it's a pawn, only include the file if the move can alter material.
+  if (is_capture && Bitboard::isPawn(type)) {
+    const Bitboard::Coord old_coord = Bitboard::squareToCoord(old_square);
+    algebraic_notation += file_string[old_coord.x];
+  }
+
+  if (is_capture) {
+    algebraic_notation += "x";
+  }
+
+  //The current square of the piece.
+  algebraic_notation += file_string[coord.x];
+  algebraic_notation += rank_string[coord.y];
+
+  //Type of termination
+  if (Globals::game_state & GameState::CHECKMATE) {
+
+    algebraic_notation += "#";
+    std::string winner = (Globals::position.side() & Bitboard::Sides::BLACK ? "1-0" : "0-1");
+    algebraic_notation += " " + winner;
+
+    current_ply_index = 0;
+  } else if (Globals::is_in_check) {
+
+    algebraic_notation += "+";
+
+  } else if (Globals::game_state & GameState::DRAW) {
+    algebraic_notation += " 1/2-1/2";
+
+    current_ply_index = 0;
+  }
+
+  algebraic_notation += " ";
+
+  return algebraic_notation;
+}
+
+//Check if the square contains a piece or not.
+bool notEmpty(const int t_square) {
+  return !Globals::position.board().isEmpty(t_square);
+}
+
+void searchForOccupiedSquares(int filter) {
+  // Reset the occupancy squares data.
+  Globals::opponent_occupancy.clear();
+
+  const Board& board = Globals::position.board();
+
+  const int side = filter & PLAYER_TO_MOVE_OCCUPIED_SQUARES_MAP ? Globals::position.side()
+                                                                 : Globals::position.side() ^ 0b11;
+
+  Bitboard::U64 pieces = board.occupancy(side);
+
+  if (filter & PAWN_OCCUPIED_SQUARES_MAP) {
+    pieces &= board.pieces(Bitboard::Pieces::P) | board.pieces(Bitboard::Pieces::p);
+  }
+
+  if (filter & KING_OCCUPIED_SQUARES_MAP) {
+    pieces &= board.pieces(Bitboard::Pieces::K) | board.pieces(Bitboard::Pieces::k);
+  }
+
+  forEachAttack(board, side, pieces, [](const int old_square, Bitboard::U64 attacks) {
+    while (attacks) {
+      Globals::opponent_occupancy.push_back(SDL_Point{Bitboard::popLSB(attacks), old_square});
+    }
+  });
+}
+
+MoveList& generateLegalMoves() {
+  generateMoves<LEGAL>(Globals::position, Globals::legal_moves);
+  return Globals::legal_moves;
+}
+
+inline const bool noMoreLegalMove() {
+  return Globals::legal_moves.empty();
+}
+
+const bool isInTerminalCondition() {
+  // The game must be terminated if it is stalemate or checkmate.
+  // We must also check for material sufficiency and threefold repetition.
+
+  return noMoreLegalMove() || Globals::position.isInsufficientMaterial() ||
+         Globals::position.isThreefoldRepetition();
+}
+
+const bool isCheckmate() {
+  // If there is no more legal moves and the king is in check. Then
+  // it must be checkmate.
+
+  Globals::is_in_check = Globals::position.isInCheck();
+  return Globals::is_in_check && noMoreLegalMove();
+}
+
+const bool isStalemate() {
+  // If there are no more legal moves and the king is not in check.
+  // Then it must be stalemate.
+
+  return !Globals::position.isInCheck() && noMoreLegalMove();
+}
+
+};  // namespace MoveGenerator
@@ -9,124 +9,61 @@ Interface::~Interface() {
 
 //TODO: Extract some regions into functions to increase clarity.
 void Interface::drop(int square, int old_square, const unsigned int flags) {
-  //Check for friendly pieces.
-  const int selected_piece_color = Bitboard::getColor(bitboard[old_square]);
-  const int target_square_color = Bitboard::getColor(bitboard[square]);
+  //Find the legal move that matches the squares. A promoting pawn
+  //is promoted to a queen since it comes first in the move list.
+  auto legal_move = std::find_if(legal_moves.begin(), legal_moves.end(), [&](const Move move) {
+    return move.to() == square && move.from() == old_square;
+  });
 
-  const bool is_friendly = selected_piece_color != target_square_color;
-  const bool is_empty = !MoveGenerator::notEmpty(square);
-
-  const bool can_place = is_friendly || is_empty;
+  if (legal_move == legal_moves.end()) {
+    return;
+  }
 
-  const bool rules = can_place && (selected_piece_color & side);
+  drop(*legal_move, flags);
+}
 
-  //Check if the square is in the hints array.
-  auto isSquareValid = [square](const LegalMove& move) {
-    return move.x == square;
-  };
+void Interface::drop(const Move move, const unsigned int flags) {
+  //Compare the whole move so that an underpromotion is not played as a queen.
+  const bool is_legal = std::find(legal_moves.begin(), legal_moves.end(), move) !=
+                        legal_moves.end();
 
-  auto it = std::find_if(move_hints.begin(), move_hints.end(), isSquareValid);
+  //Check if the move is in the hints array.
+  const bool is_hinted = std::find(move_hints.begin(), move_hints.end(), move) != move_hints.end();
 
-  if (!(rules || flags & MoveFlags::SHOULD_SUPRESS_HINTS) ||
-      !(it != move_hints.end() || flags & MoveFlags::SHOULD_SUPRESS_HINTS)) {
+  if (!is_legal || !(is_hinted || flags & MoveFlags::SHOULD_SUPRESS_HINTS)) {
     return;
   }
 
-  bool exchange_turn = flags & MoveFlags::SHOULD_EXCHANGE_TURN;
-  side ^= ((exchange_turn & 0b1) << 1) | (exchange_turn & 0b1);
+  const int square = move.to();
+  const int old_square = move.from();
 
   //Check if the move can alter material.
   bool can_alter_material = MoveGenerator::notEmpty(square);
 
-  if (!(flags & WILL_UNDO_MOVE)) {
-    auto last_move = SDL_Point{old_square, square};
-
-    // Record the previous move for the "undo" feature.
-    // clang-format off
-      const auto move = Ply {
-          last_move,
-          can_alter_material,
-          
-          bitboard[square],
-          bitboard[old_square],
-          move_bitset[old_square],
-          move_bitset[square]
-      };
-
-      Globals::move_squares.push_back(
-          std::make_tuple(square, bitboard[square], Globals::side));
-    // clang-format on
-
-    ply_array.push_back(move);
-
-    ++current_move;
-  }
-
-  //Increment the halfmove clock if it's white to move.
-  if (side & Bitboard::Sides::WHITE) {
-    Globals::halfmove_clock++;
-  }
-
-  if (can_alter_material || Bitboard::isPawn(bitboard[old_square])) {
-    Globals::halfmove_clock = 0;
-  }
-
-  bitboard[square] = bitboard[old_square];
-  bitboard[old_square] = Bitboard::e;
+  const bool is_a_castling_move = move.flag() == Move::CASTLING;
+  const bool is_en_passant = move.flag() == Move::EN_PASSANT;
 
-  //Check for pawn promotions.
-  MoveGenerator::pawnPromotion(square);
+  //Play the move and give the turn to the opponent.
+  position.doMove(move);
 
-  //Update the move bitset.
-  move_bitset[square] = true;
-  move_bitset[old_square] = false;
-
-  // Note: The IS_CASTLING flag is used for recursion to move the
-  // rook. While is_a_castling_move is used to "detect" if the legal move
-  // is considered castling.
-
-  // clang-format off
-  const bool is_a_castling_move = 
-        (square == castling_square.x || square == castling_square.y) && 
-        Bitboard::isKing(bitboard[square]) && ~(target_square_color & Globals::side);
-
-  const bool is_en_passant = ((square == en_passant) 
-                              & ~(en_passant & Bitboard::Squares::no_sq));
-  // clang-format on
-
-  if (is_a_castling_move) {
-    const int dx = square - old_square;
-
-    //Move the rook depending on which side the king castled.
-    //This is relative to the king.
-    const int new_rook_delta_pos = ((dx < 0) * 1) | ((dx > 0) * -1);
-    const int delta_old_rook_pos = ((dx < 0) * -4) | ((dx > 0) * 3);
-
-    //Move the rook to its respective square by using recursion.
-    drop(square + new_rook_delta_pos, old_square + delta_old_rook_pos,
-         SHOULD_SUPRESS_HINTS | IS_CASTLING);
-  }
-
-  if (is_en_passant) {
-    //Clear the data of the "en passant" square.
-    const int square_increment = ((Globals::side & 0b01) * 1) | ((~Globals::side & 0b01) * -1);
-    bitboard[(square_increment << 3) + square] = Bitboard::Pieces::e;
-  }
-
-  // Generate a zobrist hash and push it to the position history for threefold repetition detection.
-  const std::uint64_t zobrist_hash = Globals::zobrist_hashing->hashPosition();
-  Globals::position_history.push_back(zobrist_hash);
+  // Record the previous move for the "undo" feature.
+  ply_array.push_back(Ply{SDL_Point{old_square, square}, can_alter_material, move});
+  ++current_move;
 
   //Start the piece animation.
   elapsed_time = static_cast<double>(SDL_GetTicks());
-  linear_interpolant = Bitboard::squareToCoord(old_square);
+  const Bitboard::Coord old_coord = Bitboard::squareToCoord(old_square);
+  linear_interpolant = SDL_Point{old_coord.x, old_coord.y};
 
   scaled_linear_interpolant =
       SDL_Point{linear_interpolant.x * BOX_WIDTH, linear_interpolant.y * BOX_HEIGHT};
 
-  time = 0.0;
+  Globals::time = 0.0;
+
+  is_in_check = position.isInCheck();
 
-  is_in_check = MoveGenerator::isInCheck();
+  //Refresh the controlled squares of the adversary for the Ctrl + O overlay.
+  MoveGenerator::searchForOccupiedSquares();
 
   //Update the legal move array.
   MoveGenerator::generateLegalMoves();
@@ -134,7 +71,7 @@ void Interface::drop(int square, int old_square, const unsigned int flags) {
   //Play the audio.
   if (is_in_check) {
     //Highlight the king in check.
-    square_of_king_in_check = MoveGenerator::getOwnKing();
+    square_of_king_in_check = position.kingSquare();
     audio_manager->PlayWAV("../../res/check.wav");
   } else if (is_a_castling_move) {
     audio_manager->PlayWAV("../../res/castle.wav");
@@ -147,28 +84,26 @@ void Interface::drop(int square, int old_square, const unsigned int flags) {
   // Check for possible game terminations.
   game_state |= GameState::CHECKMATE * MoveGenerator::isCheckmate() |
                 GameState::DRAW * MoveGenerator::isStalemate() |
-                GameState::DRAW * MoveGenerator::isInsufficientMaterial() |
-                GameState::DRAW * MoveGenerator::isThreefoldRepetition() |
-                GameState::DRAW * MoveGenerator::isFiftyMoveRule();
+                GameState::DRAW * position.isInsufficientMaterial() |
+                GameState::DRAW * position.isThreefoldRepetition() |
+                GameState::DRAW * position.isFiftyMoveRule();
 
   // Log the algebraic notation of the move.
-  if (!(flags & MoveFlags::IS_CASTLING) && !(flags & MoveFlags::WILL_UNDO_MOVE)) {
-    // clang-format off
-    const int delta_x = square - old_square;
+  // clang-format off
+  const int delta_x = square - old_square;
 
-    std::cout << MoveGenerator::toAlgebraicNotation(bitboard[square], old_square, square,
-      can_alter_material || is_en_passant, is_a_castling_move, delta_x);
-    // clang-format on
-  }
+  std::cout << MoveGenerator::toAlgebraicNotation(position.board().pieceAt(square), old_square, square,
+    can_alter_material || is_en_passant, is_a_castling_move, delta_x);
+  // clang-format on
 
   if (game_state & GameState::CHECKMATE) {
-    const char* winner = (Globals::side & Bitboard::Sides::BLACK ? "White" : "Black");
+    const char* winner = (position.side() & Bitboard::Sides::BLACK ? "White" : "Black");
     std::cout << "\n\nCheckmate! " << winner << " is victorious.\n";
-  } else if (halfmove_clock >= MoveGenerator::HALFMOVE_CLOCK_THRESHOLD) {
+  } else if (position.isFiftyMoveRule()) {
     std::cout << "\n\nDraw by 50-move rule.\n";
-  } else if (MoveGenerator::isInsufficientMaterial()) {
+  } else if (position.isInsufficientMaterial()) {
     std::cout << "\n\nDraw by Insufficient Material.\n";
-  } else if (MoveGenerator::isThreefoldRepetition()) {
+  } else if (position.isThreefoldRepetition()) {
     std::cout << "\n\nDraw by Threefold Repetition.\n";
   } else if (game_state & GameState::DRAW) {
     std::cout << "\n\nDraw by Stalemate.\n";
@@ -184,27 +119,22 @@ void Interface::undo() {
     return;
   }
 
-  Ply move_data = ply_array[--current_move];
+  const Ply move_data = ply_array[--current_move];
+  ply_array.pop_back();
 
-  //TODO: Use the C++17 feature to destructure properties into individual variables.
-  SDL_Point last_move = move_data.move;
-  bool is_capture = move_data.is_capture;
-  int captured_piece = move_data.old_piece_in_dest;
+  //Take back the move and give the turn back to the previous player.
+  position.undoMove(move_data.legal_move);
 
-  bool old_move_bit = move_data.old_move_bit;
-  bool old_move_bit_in_dest = move_data.old_move_bit_in_dest;
+  is_in_check = position.isInCheck();
+  square_of_king_in_check = is_in_check ? position.kingSquare() : Bitboard::Squares::no_sq;
 
-  //Undo the move
-  drop(last_move.x, last_move.y, SHOULD_SUPRESS_HINTS | SHOULD_EXCHANGE_TURN | WILL_UNDO_MOVE);
+  game_state &= ~(GameState::CHECKMATE | GameState::DRAW);
 
-  //Put the "captured" piece back.
-  if (is_capture) {
-    Globals::bitboard[last_move.y] = captured_piece;
-  }
+  MoveGenerator::searchForOccupiedSquares();
+  MoveGenerator::generateLegalMoves();
 
-  //Recall the move bit of the piece.
-  Globals::move_bitset[last_move.x] = old_move_bit;
-  Globals::move_bitset[last_move.y] = old_move_bit_in_dest;
+  move_hints.clear();
+  Globals::selected_square = Bitboard::Squares::no_sq;
 }
 
 int Interface::AABB(int x, int y) {
@@ -215,8 +145,6 @@ int Interface::AABB(int x, int y) {
       SDL_Rect rect = quad_vector[index];
 
       if (rect.x + rect.w > x && x > rect.x && rect.y + rect.h > y && y > rect.y) {
-        MoveGenerator::searchPseudoLegalMoves(index, &MoveGenerator::renderMove);
-
         return index;
       }
     }
@@ -1,75 +1,40 @@
 #include <iostream>
 #include "mingw.thread.h"
 
+#include <algorithm>
 #include <chrono>
+#include <string>
 
 #include "game.hpp"
 
 // Flag to indicate whether the AI thread is currently computing
 bool is_ai_computing = false;
 
-void testMoveGenerationHelper(int depth) {
-  const std::vector<LegalMove> moves = MoveGenerator::generateLegalMoves(false);
-
-  if (depth <= 0) {
-    return;
-  }
-
-  for (const auto& move : moves) {
-    const ImaginaryMove& move_data = MoveGenerator::makeMove(move);
-    Globals::side ^= 0b11;
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
-
-    testMoveGenerationHelper(depth - 1);
-
-    MoveGenerator::unmakeMove(move, move_data);
-    Globals::side ^= 0b11;
-  }
-}
-
-void testMoveGeneration(Game* game_ptr) {
-  while (game_ptr->isRunning()) {
-    is_ai_computing = true;
-
-    testMoveGenerationHelper(4);
-
-    is_ai_computing = false;
-
-    // Pause for 1 second before starting the next iteration
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
-
-    break;
-  }
-}
-
-void aiThreadFunction(Game* game_ptr) {
-  while (game_ptr->isRunning()) {
-    // Set the flag to indicate that the AI thread is computing
-    is_ai_computing = true;
-
-    game_ptr->playBestMove(2, 0U);
-
-    // Reset the flag once the AI computation is done
-    is_ai_computing = false;
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-  }
-}
-
 int main(int argc, char* argv[]) {
   bool show_evaluation_bar = false;
 
+  // Number of search threads. Every thread searches the same position (Lazy SMP).
+  std::size_t num_of_threads = 1;
+
   for (int i = 1; i < argc; ++i) {
     if (std::string(argv[i]) == "--show-eval") {
       show_evaluation_bar = true;
-      break;
+    } else if (std::string(argv[i]) == "--threads" && i + 1 < argc) {
+      num_of_threads = std::max(std::stoi(argv[++i]), 1);
     }
   }
 
   auto game_ptr = std::make_unique<Game>();
 
   game_ptr->init(600 + (show_evaluation_bar * 25), 600);
+  game_ptr->setNumOfThreads(num_of_threads);
+
+  SearchLimits limits;
+  limits.move_time = Search::DEFAULT_MOVE_TIME;
+
+  // The AI checks whether it has to move every 100 milliseconds.
+  constexpr unsigned int AI_POLL_INTERVAL = 100;
+  unsigned int last_ai_poll = 0;
 
   constexpr int FPS = 60;
   constexpr int FRAME_DELAY = FPS / 1000;
@@ -77,19 +42,23 @@ int main(int argc, char* argv[]) {
   unsigned int frame_start = 0;
   int frame_time = 0;
 
-  std::thread ai_thread(aiThreadFunction, game_ptr.get());
-
   // Game Loop
   while (game_ptr->isRunning()) {
     frame_start = SDL_GetTicks();
 
     game_ptr->update();
 
-    // Only render if the AI thread is not currently computing
-    if (!is_ai_computing) {
-      game_ptr->render();
+    // The search runs on its own threads and copy of the position. It is
+    // started and its move is played from this thread.
+    if (frame_start - last_ai_poll >= AI_POLL_INTERVAL) {
+      last_ai_poll = frame_start;
+      game_ptr->playBestMove(limits, 0U);
     }
 
+    is_ai_computing = game_ptr->isThinking();
+
+    game_ptr->render();
+
     game_ptr->events(is_ai_computing);
 
     frame_time = SDL_GetTicks() - frame_start;
@@ -101,7 +70,8 @@ int main(int argc, char* argv[]) {
 
   std::cout << "\n\nWaiting for the AI thread to finish. Please wait.\n";
 
-  ai_thread.join();
+  game_ptr->stop();
+  game_ptr->waitForBestMove();
 
   return 0;
 }
\ No newline at end of file
@@ -1,245 +1,761 @@
 #include "minimax_search.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+//Reduction of the nth move of a node by the depth. Both the deeper nodes and the
+//later moves are reduced more, but ever more slowly.
+const auto REDUCTIONS = [] {
+  std::array<std::array<int, Search::MAX_REDUCED_MOVES>, Evaluation::MAX_PLY> reductions{};
+
+  for (int depth = 1; depth < Evaluation::MAX_PLY; ++depth) {
+    for (int move = 1; move < Search::MAX_REDUCED_MOVES; ++move) {
+      reductions[depth][move] = static_cast<int>(
+          Search::LMR_BASE + std::log(depth) * std::log(move) / Search::LMR_DIVISOR);
+    }
+  }
+
+  return reductions;
+}();
+
+}  // namespace
+
 Search::Search() {}
 
-Search::~Search() {}
+Search::~Search() {
+  stop();
+  waitForBestMove();
+}
+
+int Search::quiescenceSearch(Position& position, int alpha, int beta, int ply) {
+  m_pv_length[ply] = ply;
+
+  if (shouldAbort()) {
+    return 0;
+  }
+
+  //Only this thread writes the counter. Other threads may read it.
+  m_qnodes.store(m_qnodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 
-//#define USE_QUIESCENCE_SEARCH
+  m_seldepth = std::max(m_seldepth, ply);
 
-//Prevent the horizon effect by scanning every possible captures and checks.
-//TODO: Implement delta pruning for performance optimization.
-[[nodiscard]] const int Search::quiescenceSearch(int alpha, int beta) {
-  // Perform static evaluation of the current position
-  int staticEval = Evaluation::evaluateFactors();
+  const bool is_in_check = position.isInCheck();
 
-  // Check if the position is already quiet (no capturing moves available)
-  if (staticEval >= beta) {
-    return beta;
+  if (ply >= Evaluation::MAX_PLY - 1) {
+    return is_in_check ? 0 : Evaluation::evaluateFactors(position);
   }
 
-  // Update alpha with the maximum of alpha and static evaluation
-  alpha = std::max(alpha, staticEval);
+  int best_score = -Evaluation::INFINITE_SCORE;
+  int static_eval = 0;
 
-  // Compute the delta value for delta pruning
-  int delta = 100;  // Adjust this value based on your specific game characteristics
+  //Standing pat is not an option in check, so every evasion is searched.
+  if (!is_in_check) {
+    //The side to move can usually do at least as well as the static evaluation
+    //by not capturing at all. (Stand pat)
+    static_eval = Evaluation::evaluateFactors(position);
 
-  // Generate and evaluate capturing moves in the current position
-  std::vector<LegalMove> capturingMoves = moveOrdering(true);
+    if (static_eval >= beta) {
+      return static_eval;
+    }
 
-  for (const LegalMove& move : capturingMoves) {
-    const auto& moveData = MoveGenerator::makeMove(move);
-    Globals::side ^= 0b11;
+    alpha = std::max(alpha, static_eval);
+    best_score = static_eval;
+  }
 
-    int score = -quiescenceSearch(-beta, -alpha);
+  MovePicker move_picker(position);
+  int num_of_moves = 0;
 
-    MoveGenerator::unmakeMove(move, moveData);
-    Globals::side ^= 0b11;
+  for (Move move = move_picker.next(); !move.isNull(); move = move_picker.next()) {
+    ++num_of_moves;
 
-    // Check if the score surpasses the current alpha value
-    if (score >= beta) {
-      return beta;  // Return the beta value as a cutoff
+    if (!is_in_check) {
+      //Even winning the captured piece for free would not raise alpha. (Delta pruning)
+      if (!move.isPromotion() &&
+          static_eval + Evaluation::capturedValue(position.board(), move) + DELTA_MARGIN <= alpha) {
+        continue;
+      }
+
+      //The exchange on the target square loses material.
+      if (!position.see(move, 0)) {
+        continue;
+      }
+    }
+
+    position.doMove(move);
+
+    const int score = -quiescenceSearch(position, -beta, -alpha, ply + 1);
+
+    position.undoMove(move);
+
+    if (m_stop.load(std::memory_order_relaxed)) {
+      return 0;
     }
 
-    // Check if the score surpasses the current alpha value minus delta
-    if (score > alpha) {
-      alpha = score;  // Update alpha with the new score
+    if (score > best_score) {
+      best_score = score;
+
+      if (score > alpha) {
+        alpha = score;
 
-      // Check if the score surpasses beta minus delta
-      if (alpha >= beta - delta) {
-        return alpha;  // Return alpha if it is close to beta (prune further exploration)
+        if (alpha >= beta) {
+          break;
+        }
       }
     }
   }
 
-  // Return the final alpha value as the result of the quiescence search
-  return alpha;
+  if (is_in_check && num_of_moves == 0) {
+    return -(Evaluation::MATE_SCORE - ply);
+  }
+
+  return best_score;
 }
 
-[[nodiscard]] int Search::minimaxSearch(int depth, int alpha, int beta, bool is_maximizing) {
-  if (depth == 0) {
-#ifdef USE_QUIESCENCE_SEARCH
-    // Continue searching for captures or checks to prevent the
-    // horizon effect.
-    return quiescenceSearch(alpha, beta);
-#else
-    return Evaluation::evaluateFactors();
-#endif
+[[nodiscard]] int Search::negamaxSearch(Position& position, int depth, int alpha, int beta,
+                                       int ply) {
+  //A null window can not produce an exact score, so only the other nodes can be
+  //on the principal variation.
+  const bool is_pv_node = beta - alpha > 1;
+
+  m_pv_length[ply] = ply;
+
+  if (shouldAbort()) {
+    return 0;
   }
 
-  const std::vector<LegalMove> legal_moves_copy = moveOrdering();
+  m_seldepth = std::max(m_seldepth, ply);
 
-  if (MoveGenerator::isCheckmate()) {
-      return INT_MIN + depth;
+  // Scores in the transposition table and of the evaluation are relative to the
+  // side to move, like the scores of this search.
+  if (depth <= 0 || ply >= Evaluation::MAX_PLY - 1) {
+    return quiescenceSearch(position, alpha, beta, ply);
   }
 
-  if (MoveGenerator::isStalemate() || MoveGenerator::isInsufficientMaterial() ||
-      MoveGenerator::isThreefoldRepetition() || MoveGenerator::isFiftyMoveRule()) {
+  if (position.isInsufficientMaterial() || position.isThreefoldRepetition()) {
     return 0;
   }
 
-  if (is_maximizing) {
-    int maxEval = INT_MIN;
+  //Being mated on the last move before the fifty-move rule still loses.
+  if (position.isFiftyMoveRule()) {
+    if (!position.isInCheck()) {
+      return 0;
+    }
+
+    MoveList evasions;
+    MoveGenerator::generateLegalMoves(position, evasions);
+
+    return evasions.empty() ? -(Evaluation::MATE_SCORE - ply) : 0;
+  }
+
+  TranspositionTable& transposition_table = *Globals::transposition_table;
+  const std::uint64_t key = position.key();
+
+  TranspositionTable::Entry entry;
+  Move tt_move;
+
+  if (transposition_table.probe(key, entry)) {
+    tt_move = entry.move;
+
+    //A cutoff in a PV node would cut the principal variation short.
+    if (!is_pv_node && entry.depth >= depth) {
+      const int score = TranspositionTable::scoreFromTT(entry.score, ply);
+
+      if (entry.bound == TranspositionTable::BOUND_EXACT ||
+          (entry.bound == TranspositionTable::BOUND_LOWER && score >= beta) ||
+          (entry.bound == TranspositionTable::BOUND_UPPER && score <= alpha)) {
+        return score;
+      }
+    }
+  }
 
-    for (const LegalMove& move : legal_moves_copy) {
-      const auto& move_data = MoveGenerator::makeMove(move);
+  const int original_alpha = alpha;
 
-      Globals::side ^= 0b11;
+  Move best_move;
+  int best_score = -Evaluation::INFINITE_SCORE;
 
-      int score = 0;
+  const bool is_in_check = position.isInCheck();
 
-      score = minimaxSearch(depth - 1, alpha, beta, false);
+  //The static evaluation means nothing in check, where every evasion is searched.
+  const int static_eval =
+      is_in_check ? -Evaluation::INFINITE_SCORE : Evaluation::evaluateFactors(position);
 
-      MoveGenerator::unmakeMove(move, move_data);
+  if (!is_pv_node && !is_in_check && std::abs(beta) < Evaluation::MATE_IN_MAX_PLY) {
+    //The side to move is so far ahead that no move of the opponent within the
+    //remaining depth is expected to make up for it. (Reverse futility pruning)
+    if (depth <= m_pruning.reverse_futility_max_depth &&
+        static_eval - m_pruning.reverse_futility_margin * depth >= beta) {
+      return static_eval;
+    }
 
-      Globals::side ^= 0b11;
+    //The side to move is so far behind that only a tactic could save it, which
+    //the quiescence search would find. (Razoring)
+    if (depth <= m_pruning.razoring_max_depth &&
+        static_eval + m_pruning.razoring_base + m_pruning.razoring_margin * depth <= alpha) {
+      const int score = quiescenceSearch(position, alpha, alpha + 1, ply);
 
-      maxEval = std::max(score, maxEval);
-      alpha = std::max(alpha, maxEval);
+      if (m_stop.load(std::memory_order_relaxed)) {
+        return 0;
+      }
 
-      if (alpha >= beta) {
-        break;  // Alpha-beta pruning
+      if (score <= alpha) {
+        return score;
       }
     }
+  }
+
+  //Passing is almost always worse than the best move, so a side that still beats
+  //beta after passing would beat it with a move too. (Null-move pruning)
+  if (!is_pv_node && depth >= NULL_MOVE_MIN_DEPTH && ply > 0 && ply >= m_null_move_min_ply &&
+      !m_move_stack[ply - 1].isNull() && std::abs(beta) < Evaluation::MATE_IN_MAX_PLY &&
+      !is_in_check && position.hasNonPawnMaterial() && static_eval >= beta) {
+    const int reduced_depth = std::max(depth - NULL_MOVE_REDUCTION - depth / 6, 0);
 
-    return maxEval;
-  } else {
-    int minEval = INT_MAX;
+    m_move_stack[ply] = Move();
+    position.doNullMove();
 
-    for (const LegalMove& move : legal_moves_copy) {
-      const auto& move_data = MoveGenerator::makeMove(move);
+    int score = -negamaxSearch(position, reduced_depth, -beta, -beta + 1, ply + 1);
 
-      Globals::side ^= 0b11;
+    position.undoNullMove();
 
-      int score = 0;
+    if (m_stop.load(std::memory_order_relaxed)) {
+      return 0;
+    }
+
+    if (score >= beta) {
+      //A mate found after passing is not proven.
+      score = std::min(score, Evaluation::MATE_IN_MAX_PLY - 1);
 
-      score = minimaxSearch(depth - 1, alpha, beta, true);
+      if (depth < NULL_MOVE_VERIFICATION_DEPTH) {
+        return score;
+      }
 
-      MoveGenerator::unmakeMove(move, move_data);
+      //Zugzwang can remain in positions with pieces. Verify the cutoff with
+      //a reduced search in which this side can not pass.
+      const int null_move_min_ply = m_null_move_min_ply;
+      m_null_move_min_ply = ply + 3 * reduced_depth / 4;
 
-      Globals::side ^= 0b11;
+      const int verification = negamaxSearch(position, reduced_depth, beta - 1, beta, ply);
 
-      minEval = std::min(score, minEval);
-      beta = std::min(beta, minEval);
+      m_null_move_min_ply = null_move_min_ply;
 
-      if (alpha >= beta) {
-        break;  // Alpha-beta pruning
+      if (verification >= beta) {
+        return score;
       }
     }
+  }
+
+  const Move counter_move =
+      ply > 0 && !m_move_stack[ply - 1].isNull()
+          ? m_counter_moves.at(position.board(), m_move_stack[ply - 1])
+          : Move();
+
+  MovePicker move_picker(position, tt_move, m_killers.at(ply), counter_move, m_history);
+  int num_of_moves = 0;
+
+  //The quiet moves that did not cause a cutoff lose history.
+  std::array<Move, 64> searched_quiets;
+  int num_of_searched_quiets = 0;
+
+  for (Move move = move_picker.next(); !move.isNull(); move = move_picker.next()) {
+    const bool is_quiet = position.isQuiet(move);
+
+    //Moves are only pruned once a move was searched and the side is not getting
+    //mated, so that mates and stalemates are still found.
+    const bool can_prune =
+        !is_in_check && num_of_moves > 0 && best_score > -Evaluation::MATE_IN_MAX_PLY;
+
+    if (can_prune) {
+      //The quiet moves ordered this late rarely matter. (Late move pruning)
+      if (is_quiet && depth <= m_pruning.late_move_max_depth &&
+          num_of_searched_quiets >= m_pruning.late_move_base + depth * depth) {
+        move_picker.skipQuiets();
+        continue;
+      }
+
+      if (!is_quiet && depth <= m_pruning.see_max_depth &&
+          !position.see(move, -m_pruning.see_capture_margin * depth)) {
+        continue;
+      }
+    }
+
+    const bool gives_check = position.givesCheck(move);
+
+    //A quiet move can not raise the static evaluation enough to reach alpha.
+    //(Futility pruning)
+    if (can_prune && is_quiet && !gives_check && depth <= m_pruning.futility_max_depth &&
+        static_eval + m_pruning.futility_base + m_pruning.futility_margin * depth <= alpha) {
+      continue;
+    }
+
+    m_move_stack[ply] = move;
+    position.doMove(move);
+
+    //Late quiet moves rarely beat the moves ordered before them, so they are
+    //searched shallower first. (Late move reductions)
+    int reduction = 0;
+
+    if (depth >= LMR_MIN_DEPTH && num_of_moves >= LMR_MIN_MOVES && is_quiet && !is_in_check &&
+        !gives_check) {
+      reduction = REDUCTIONS[std::min(depth, Evaluation::MAX_PLY - 1)]
+                            [std::min(num_of_moves, MAX_REDUCED_MOVES - 1)];
+
+      //The moves of the expected line and the refutations deserve a closer look.
+      reduction -= is_pv_node;
+      reduction -= move == m_killers.at(ply)[0] || move == m_killers.at(ply)[1] ||
+                   move == counter_move;
+      reduction -= m_history.score(position.side() ^ 0b11, move) / LMR_HISTORY_DIVISOR;
+
+      //Leave at least one ply to search.
+      reduction = std::clamp(reduction, 0, depth - 2);
+    }
+
+    const int score =
+        searchMove(position, depth - 1, alpha, beta, ply + 1, num_of_moves == 0, reduction);
+
+    position.undoMove(move);
+
+    ++num_of_moves;
+
+    //The score of an aborted search must not be used or stored.
+    if (m_stop.load(std::memory_order_relaxed)) {
+      return 0;
+    }
+
+    if (score > best_score) {
+      best_score = score;
+      best_move = move;
+
+      if (score > alpha) {
+        alpha = score;
+        updatePV(ply, move);
+
+        if (alpha >= beta) {
+          if (is_quiet) {
+            updateQuietStats(position, move, searched_quiets.data(), num_of_searched_quiets,
+                             depth, ply);
+          }
+
+          break;  // Beta cutoff
+        }
+      }
+    }
+
+    if (is_quiet && num_of_searched_quiets < static_cast<int>(searched_quiets.size())) {
+      searched_quiets[num_of_searched_quiets++] = move;
+    }
+  }
+
+  if (num_of_moves == 0) {
+    // Prefer the fastest mate and the slowest defeat.
+    return is_in_check ? -(Evaluation::MATE_SCORE - ply) : 0;
+  }
+
+  auto bound = TranspositionTable::BOUND_EXACT;
+
+  if (best_score <= original_alpha) {
+    bound = TranspositionTable::BOUND_UPPER;
+  } else if (best_score >= beta) {
+    bound = TranspositionTable::BOUND_LOWER;
+  }
+
+  transposition_table.store(key, depth, TranspositionTable::scoreToTT(best_score, ply), bound,
+                            best_move);
+
+  return best_score;
+}
+
+int Search::searchMove(Position& position, int depth, int alpha, int beta, int ply,
+                       bool is_first_move, int reduction) {
+  //The first move is expected to be the best one, so it gets the full window.
+  if (is_first_move) {
+    return -negamaxSearch(position, depth, -beta, -alpha, ply);
+  }
+
+  //The other moves only have to be proven worse than alpha, which a null window
+  //does more cheaply.
+  int score = 0;
+
+  //A reduced move that beats alpha is searched again at the full depth.
+  if (reduction > 0) {
+    score = -negamaxSearch(position, depth - reduction, -alpha - 1, -alpha, ply);
+
+    if (score <= alpha || m_stop.load(std::memory_order_relaxed)) {
+      return score;
+    }
+  }
+
+  score = -negamaxSearch(position, depth, -alpha - 1, -alpha, ply);
+
+  //The move may be better after all. Search it again to get its exact score.
+  if (score > alpha && score < beta && !m_stop.load(std::memory_order_relaxed)) {
+    score = -negamaxSearch(position, depth, -beta, -alpha, ply);
+  }
+
+  return score;
+}
+
+void Search::updateQuietStats(const Position& position, Move move, const Move* searched_quiets,
+                              int num_of_searched_quiets, int depth, int ply) {
+  const int bonus = HistoryTable::bonus(depth);
 
-    return minEval;
+  m_killers.store(ply, move);
+  m_history.update(position.side(), move, bonus);
+
+  for (int i = 0; i < num_of_searched_quiets; ++i) {
+    m_history.update(position.side(), searched_quiets[i], -bonus);
+  }
+
+  if (ply > 0 && !m_move_stack[ply - 1].isNull()) {
+    m_counter_moves.store(position.board(), m_move_stack[ply - 1], move);
+  }
+}
+
+void Search::updatePV(int ply, const Move move) {
+  m_pv_table[ply][ply] = move;
+
+  for (int i = ply + 1; i < m_pv_length[ply + 1]; ++i) {
+    m_pv_table[ply][i] = m_pv_table[ply + 1][i];
   }
+
+  m_pv_length[ply] = m_pv_length[ply + 1];
 }
 
-const std::vector<LegalMove>& Search::moveOrdering(bool only_captures) {
-  std::vector<LegalMove>& moves = MoveGenerator::generateLegalMoves(only_captures);
+void Search::moveOrdering(const Position& position, MoveList& moves, const Move tt_move) {
+  const Board& board = position.board();
+
+  MoveGenerator::generateLegalMoves(position, moves);
 
-  for (LegalMove& move : moves) {
-    move.score = 0;
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    const Move move = moves[i];
+    int& score = moves.score(i);
+
+    // The best move of a previous search of the position is searched first.
+    if (move == tt_move) {
+      score = Evaluation::INFINITE_SCORE;
+      continue;
+    }
 
-    const int move_piece_type = Globals::bitboard[move.y];
-    const int target_piece_type = Globals::bitboard[move.x];
+    const int move_piece_type = board.pieceAt(move.from());
+    const int target_piece_type = board.pieceAt(move.to());
 
     if (target_piece_type != Bitboard::Pieces::e && !Bitboard::isKing(target_piece_type)) {
-      move.score = 10 * Evaluation::getPieceValue(target_piece_type) -
-                   Evaluation::getPieceValue(move_piece_type);
+      score = 10 * Evaluation::getPieceValue(target_piece_type) -
+              Evaluation::getPieceValue(move_piece_type);
     }
 
     //Look for pawn promotion.
-    if (Bitboard::isPawn(move_piece_type) &&
-        move.x >> 3 == (7 * (Bitboard::getColor(move_piece_type) & 0b01))) {
-      move.score += 900;  //Due to auto-queen.
+    if (move.isPromotion()) {
+      score += Evaluation::getPieceValue(move.promotionType());
     }
 
-    //It's usually a bad idea to put a valuable piece in a pawn attack.
-    MoveGenerator::searchForOccupiedSquares(MoveGenerator::PAWN_OCCUPIED_SQUARES_MAP);
+    //The piece can be won by the opponent, whether it captured or not.
+    if (!position.see(move, 0)) {
+      score -= Evaluation::LOSING_EXCHANGE_PENALTY;
+    }
+
+    //Evaluate piece square tables.
+    score += 10 * Evaluation::getSquareValue(position.side(), move.to(), move_piece_type);
+  }
+
+  // Sort in descending order
+  moves.sortByScore();
+}
+
+int Search::searchRoot(Position& position, MoveList& root_moves, int depth, int alpha,
+                       int beta) {
+  int best_score = -Evaluation::INFINITE_SCORE;
+  std::size_t best_index = 0;
+
+  m_pv_length[0] = 0;
+
+  for (std::size_t i = 0; i < root_moves.size(); ++i) {
+    const Move move = root_moves[i];
+
+    m_move_stack[0] = move;
+    position.doMove(move);
 
-    auto attackedByPawn = [move_piece_type, &move](const SDL_Point& occupied_square) {
-      return occupied_square.x == move.x;
-    };
+    const int score = searchMove(position, depth - 1, alpha, beta, 1, i == 0);
 
-    const bool will_pawn_capture = std::any_of(Globals::opponent_occupancy.begin(),
-                                               Globals::opponent_occupancy.end(), attackedByPawn);
+    position.undoMove(move);
 
-    if (will_pawn_capture) {
-      //Penalty for moving squares to attacked squares.
-      move.score -= Evaluation::PAWN_CAPTURE_PENALTY;
+    if (m_stop.load(std::memory_order_relaxed)) {
+      return best_score;
     }
 
-    //Evaluate piece square tables.
-    move.score += 10 * Evaluation::getSquareValue(Globals::side, move.x, move_piece_type);
+    if (score > best_score) {
+      best_score = score;
+      best_index = i;
+
+      if (score > alpha) {
+        alpha = score;
+        updatePV(0, move);
 
-    MoveGenerator::searchForOccupiedSquares();
+        if (alpha >= beta) {
+          break;
+        }
+      }
+    }
   }
 
-  std::sort(moves.begin(), moves.end(), [](const LegalMove& a, const LegalMove& b) {
-    return a.score > b.score;  // Sort in descending order
-  });
+  //Search the best move first in the next iteration.
+  std::rotate(root_moves.begin(), root_moves.begin() + best_index,
+              root_moves.begin() + best_index + 1);
 
-  return moves;
+  return best_score;
 }
 
-void Search::playRandomly() {
-  if (Globals::side & Bitboard::Sides::WHITE) {
-    return;
+Move Search::iterativeDeepening(Position& position, int thread_id) {
+  MoveList root_moves;
+  moveOrdering(position, root_moves);
+
+  if (root_moves.empty()) {
+    return Move();
   }
 
-  Globals::move_delay++;
+  const int max_depth =
+      m_limits.max_depth > 0 ? std::min(m_limits.max_depth, Evaluation::MAX_PLY - 1)
+                             : Evaluation::MAX_PLY - 1;
+
+  //Fall back to the first ordered move if not even depth 1 completes.
+  Move best_move = root_moves[0];
+  int score = 0;
+
+  for (int depth = 1; depth <= max_depth; ++depth) {
+    if (thread_id > 0) {
+      const int pattern = (thread_id - 1) % NUM_OF_SKIP_PATTERNS;
+
+      if (((depth + SKIP_PHASE[pattern]) / SKIP_SIZE[pattern]) % 2) {
+        continue;
+      }
+    }
+
+    int delta = ASPIRATION_WINDOW;
+
+    int alpha = -Evaluation::INFINITE_SCORE;
+    int beta = Evaluation::INFINITE_SCORE;
+
+    //Expect the score to stay close to the one of the previous iteration.
+    if (depth > 1) {
+      alpha = std::max(score - delta, -Evaluation::INFINITE_SCORE);
+      beta = std::min(score + delta, Evaluation::INFINITE_SCORE);
+    }
+
+    while (true) {
+      const int result = searchRoot(position, root_moves, depth, alpha, beta);
+
+      if (m_stop.load(std::memory_order_relaxed)) {
+        break;
+      }
 
-  if (Globals::move_delay >= 30) {
-    MoveGenerator::generateLegalMoves();
+      //Widen the window on the failing side and search again.
+      if (result <= alpha) {
+        alpha = std::max(result - delta, -Evaluation::INFINITE_SCORE);
+      } else if (result >= beta) {
+        beta = std::min(result + delta, Evaluation::INFINITE_SCORE);
+      } else {
+        score = result;
+        break;
+      }
 
-    int random = rand() % (static_cast<int>(Globals::legal_moves.size()));
+      delta *= 2;
+    }
 
-    //En passant is forced.
-    if (!(Globals::en_passant & Bitboard::Squares::no_sq) &&
-        Globals::en_passant_legal_move_index >= 0) {
-      random = Globals::en_passant_legal_move_index;
+    //Only the move of a completed iteration can be trusted.
+    if (m_stop.load(std::memory_order_relaxed)) {
+      break;
     }
 
-    Globals::interface_handler->drop(Globals::legal_moves[random].x, Globals::legal_moves[random].y,
-                                     SHOULD_SUPRESS_HINTS | SHOULD_EXCHANGE_TURN);
+    best_move = root_moves[0];
+
+    if (thread_id == 0 && m_info_callback) {
+      SearchInfo info;
+
+      info.depth = depth;
+      info.seldepth = std::max(m_seldepth, depth);
+      info.score = score;
+      info.nodes = nodes();
+      info.time = m_time_manager.elapsed();
+      info.hashfull = Globals::transposition_table->hashfull();
+      info.pv.assign(m_pv_table[0].begin(), m_pv_table[0].begin() + m_pv_length[0]);
 
-    Globals::move_delay = 0;
+      m_info_callback(info);
+    }
+
+    //The next iteration would most likely not finish in time.
+    if (m_time_manager.isTimeLimited() && !m_pondering.load(std::memory_order_relaxed) &&
+        m_time_manager.elapsed() >= m_time_manager.optimumTime()) {
+      break;
+    }
   }
+
+  return best_move;
 }
 
-void Search::playBestMove(int depth, const unsigned int human_player) {
-  if (Globals::side & human_player) {
-    return;
+Move Search::think(const Position& root, const SearchLimits& limits) {
+  m_limits = limits;
+  m_time_manager.init(limits);
+
+  m_nodes = 0;
+  m_qnodes = 0;
+  m_seldepth = 0;
+  m_null_move_min_ply = 0;
+  m_pondering = limits.ponder;
+
+  // Age the entries of the previous search.
+  Globals::transposition_table->newSearch();
+
+  m_history.age();
+  m_killers.clear();
+
+  //The helpers search until this thread stops them.
+  SearchLimits helper_limits;
+  helper_limits.max_depth = limits.max_depth;
+  helper_limits.infinite = true;
+
+  std::vector<std::thread> helper_threads;
+
+  for (std::size_t i = 0; i < m_helpers.size(); ++i) {
+    Search& helper = *m_helpers[i];
+
+    helper.m_limits = helper_limits;
+    helper.m_time_manager.init(helper_limits);
+
+    helper.m_nodes = 0;
+    helper.m_qnodes = 0;
+
+    helper.m_history.age();
+    helper.m_killers.clear();
+
+    helper_threads.emplace_back([&helper, &root, i]() {
+      Position position = root;
+      (void)helper.iterativeDeepening(position, static_cast<int>(i) + 1);
+    });
   }
 
-  Globals::move_delay++;
+  Position position = root;
+  const Move best_move = iterativeDeepening(position);
 
-  if (Globals::move_delay < 3 || MoveGenerator::isInTerminalCondition()) {
-    return;
+  //The move must not be played before the search is stopped or the opponent
+  //plays the expected move, even if the search could not go any deeper.
+  while (!m_stop.load(std::memory_order_relaxed) &&
+         (m_limits.infinite || m_pondering.load(std::memory_order_relaxed))) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  for (auto& helper : m_helpers) {
+    helper->stop();
   }
 
-  SDL_SetWindowTitle(Globals::window, "NeuralChess [Thinking...]");
+  for (auto& thread : helper_threads) {
+    thread.join();
+  }
 
-  const std::vector<LegalMove> legal_moves_copy = MoveGenerator::generateLegalMoves();
+  return best_move;
+}
 
-  int best_score = INT_MIN;
-  LegalMove best_move = legal_moves_copy.back();
+void Search::startThinking(const Position& position, const SearchLimits& limits) {
+  waitForBestMove();
 
-  for (const LegalMove& move : legal_moves_copy) {
-    const auto& move_data = MoveGenerator::makeMove(move);
-    Globals::side ^= 0b11;
+  //A stop() right after this call must not be cleared by the new thread.
+  clearStop();
 
-    int score = -minimaxSearch(depth, INT_MIN, INT_MAX, true);
+  m_is_thinking = true;
 
-    if (score > best_score) {
-      best_score = score;
-      best_move = move;
-    }
+  m_search_thread = std::thread([this, limits, root = position]() {
+    m_best_move = think(root, limits);
+    m_is_thinking = false;
+  });
+}
+
+Move Search::waitForBestMove() {
+  if (m_search_thread.joinable()) {
+    m_search_thread.join();
+  }
+
+  return m_best_move;
+}
+
+void Search::stop() noexcept {
+  m_stop = true;
 
-    MoveGenerator::unmakeMove(move, move_data);
-    Globals::side ^= 0b11;
+  for (auto& helper : m_helpers) {
+    helper->stop();
   }
+}
+
+void Search::clearStop() noexcept {
+  m_stop = false;
 
-  Globals::interface_handler->drop(best_move.x, best_move.y,
-                                   SHOULD_SUPRESS_HINTS | SHOULD_EXCHANGE_TURN);
+  for (auto& helper : m_helpers) {
+    helper->clearStop();
+  }
+}
 
-  Globals::move_delay = 0;
+void Search::setPruningParameters(const PruningParameters& parameters) {
+  m_pruning = parameters;
+
+  for (auto& helper : m_helpers) {
+    helper->setPruningParameters(parameters);
+  }
+}
 
-  SDL_SetWindowTitle(Globals::window, "NeuralChess");
-}
\ No newline at end of file
+void Search::clearHistory() noexcept {
+  m_killers.clear();
+  m_history.clear();
+  m_counter_moves.clear();
+
+  for (auto& helper : m_helpers) {
+    helper->clearHistory();
+  }
+}
+
+void Search::ponderhit() noexcept {
+  m_pondering = false;
+}
+
+void Search::setNumOfThreads(std::size_t num_of_threads) {
+  m_helpers.clear();
+
+  for (std::size_t i = 1; i < num_of_threads; ++i) {
+    m_helpers.push_back(std::make_unique<Search>());
+    m_helpers.back()->setPruningParameters(m_pruning);
+  }
+}
+
+std::uint64_t Search::qnodes() const noexcept {
+  std::uint64_t nodes = m_qnodes.load(std::memory_order_relaxed);
+
+  for (const auto& helper : m_helpers) {
+    nodes += helper->qnodes();
+  }
+
+  return nodes;
+}
+
+std::uint64_t Search::nodes() const noexcept {
+  std::uint64_t nodes = m_nodes.load(std::memory_order_relaxed);
+
+  for (const auto& helper : m_helpers) {
+    nodes += helper->nodes();
+  }
+
+  return nodes;
+}
+
+void Search::checkLimits() {
+  if (m_limits.max_nodes > 0 && nodes() >= m_limits.max_nodes) {
+    m_stop = true;
+  }
+
+  //The clock of the engine only runs once the opponent played the expected move.
+  if (m_pondering.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  if (m_time_manager.isTimeLimited() && m_time_manager.elapsed() >= m_time_manager.maximumTime()) {
+    m_stop = true;
+  }
+}
@@ -0,0 +1,261 @@
+#include "move_picker.hpp"
+#include "evaluation.hpp"
+
+#include <algorithm>
+
+namespace {
+
+//Every capture of an evasion is searched before the quiet evasions.
+constexpr int EVASION_CAPTURE_BONUS = 100000;
+
+bool isCapture(const Board& board, const Move move) {
+  return move.flag() == Move::EN_PASSANT || !board.isEmpty(move.to());
+}
+
+bool contains(const MoveList& moves, const Move move) {
+  return std::find(moves.begin(), moves.end(), move) != moves.end();
+}
+
+}  // namespace
+
+MovePicker::MovePicker(const Position& position, Move tt_move,
+                       const KillerTable::Killers& killers, Move counter_move,
+                       const HistoryTable& history)
+    : m_position(position),
+      m_tt_move(tt_move),
+      m_refutations{killers[0], killers[1], counter_move},
+      m_history(&history) {
+  m_stage = position.isInCheck() ? EVASIONS_TT : MAIN_TT;
+}
+
+MovePicker::MovePicker(const Position& position)
+    : m_position(position), m_tt_move(Move()), m_stage(QSEARCH_INIT) {}
+
+Move MovePicker::next() {
+  switch (m_stage) {
+    case MAIN_TT:
+    case EVASIONS_TT:
+      m_stage = m_stage == MAIN_TT ? CAPTURES_INIT : EVASIONS_INIT;
+
+      if (isLegalTTMove()) {
+        return m_tt_move;
+      }
+
+      return next();
+
+    case CAPTURES_INIT:
+      if (!m_captures_generated) {
+        MoveGenerator::generateMoves<MoveGenerator::CAPTURES>(m_position, m_captures);
+      }
+
+      scoreCaptures(m_captures);
+
+      m_index = 0;
+      m_stage = GOOD_CAPTURES;
+      return next();
+
+    case GOOD_CAPTURES:
+      while (m_index < m_captures.size()) {
+        const Move move = m_captures.pickBest(m_index++);
+
+        if (move == m_tt_move) {
+          continue;
+        }
+
+        if (m_position.see(move, 0)) {
+          return move;
+        }
+
+        //The slots before the index were already yielded, so they can be reused.
+        m_captures[m_num_of_bad_captures++] = move;
+      }
+
+      m_index = 0;
+      m_stage = REFUTATIONS;
+      return next();
+
+    case REFUTATIONS:
+      while (!m_skip_quiets && m_index < m_refutations.size()) {
+        if (isNewRefutation(m_index++)) {
+          return m_refutations[m_index - 1];
+        }
+      }
+
+      m_stage = QUIETS_INIT;
+      return next();
+
+    case QUIETS_INIT:
+      if (m_skip_quiets) {
+        m_index = 0;
+        m_stage = BAD_CAPTURES;
+        return next();
+      }
+
+      if (!m_quiets_generated) {
+        MoveGenerator::generateMoves<MoveGenerator::QUIETS>(m_position, m_quiets);
+      }
+
+      scoreQuiets(m_quiets);
+
+      m_index = 0;
+      m_stage = QUIETS;
+      return next();
+
+    case QUIETS:
+      while (!m_skip_quiets && m_index < m_quiets.size()) {
+        const Move move = m_quiets.pickBest(m_index++);
+
+        if (move != m_tt_move && !isRefutation(move)) {
+          return move;
+        }
+      }
+
+      m_index = 0;
+      m_stage = BAD_CAPTURES;
+      return next();
+
+    case BAD_CAPTURES:
+      if (m_index < m_num_of_bad_captures) {
+        return m_captures[m_index++];
+      }
+
+      m_stage = DONE;
+      return Move();
+
+    case EVASIONS_INIT:
+    case QSEARCH_INIT:
+      if (m_position.isInCheck()) {
+        if (!m_captures_generated) {
+          MoveGenerator::generateMoves<MoveGenerator::EVASIONS>(m_position, m_captures);
+        }
+
+        //A capture scores by MVV-LVA and a quiet evasion by its square.
+        scoreQuiets(m_captures);
+
+        for (std::size_t i = 0; i < m_captures.size(); ++i) {
+          const Move move = m_captures[i];
+
+          if (isCapture(m_position.board(), move)) {
+            m_captures.score(i) =
+                EVASION_CAPTURE_BONUS + 10 * Evaluation::capturedValue(m_position.board(), move) -
+                Evaluation::getPieceValue(m_position.board().pieceAt(move.from()));
+          }
+        }
+      } else {
+        MoveGenerator::generateMoves<MoveGenerator::CAPTURES>(m_position, m_captures);
+        scoreCaptures(m_captures);
+      }
+
+      m_index = 0;
+      m_stage = m_stage == EVASIONS_INIT ? EVASIONS : QSEARCH_CAPTURES;
+      return next();
+
+    case EVASIONS:
+    case QSEARCH_CAPTURES:
+      while (m_index < m_captures.size()) {
+        const Move move = m_captures.pickBest(m_index++);
+
+        if (move != m_tt_move) {
+          return move;
+        }
+      }
+
+      m_stage = DONE;
+      return Move();
+
+    case DONE:
+      break;
+  }
+
+  return Move();
+}
+
+bool MovePicker::isLegalTTMove() {
+  if (m_tt_move.isNull()) {
+    return false;
+  }
+
+  if (m_stage == EVASIONS_INIT) {
+    MoveGenerator::generateMoves<MoveGenerator::EVASIONS>(m_position, m_captures);
+    m_captures_generated = true;
+
+    return contains(m_captures, m_tt_move);
+  }
+
+  if (!m_position.isQuiet(m_tt_move)) {
+    MoveGenerator::generateMoves<MoveGenerator::CAPTURES>(m_position, m_captures);
+    m_captures_generated = true;
+
+    return contains(m_captures, m_tt_move);
+  }
+
+  MoveGenerator::generateMoves<MoveGenerator::QUIETS>(m_position, m_quiets);
+  m_quiets_generated = true;
+
+  return contains(m_quiets, m_tt_move);
+}
+
+bool MovePicker::isNewRefutation(std::size_t index) {
+  const Move move = m_refutations[index];
+
+  if (move.isNull() || move == m_tt_move ||
+      std::find(m_refutations.begin(), m_refutations.begin() + index, move) !=
+          m_refutations.begin() + index) {
+    return false;
+  }
+
+  //A refutation of another position may be a capture or illegal here.
+  if (!m_position.isQuiet(move)) {
+    return false;
+  }
+
+  if (!m_quiets_generated) {
+    MoveGenerator::generateMoves<MoveGenerator::QUIETS>(m_position, m_quiets);
+    m_quiets_generated = true;
+  }
+
+  return contains(m_quiets, move);
+}
+
+bool MovePicker::isRefutation(Move move) const noexcept {
+  return std::find(m_refutations.begin(), m_refutations.end(), move) != m_refutations.end();
+}
+
+void MovePicker::scoreCaptures(MoveList& moves) const {
+  const Board& board = m_position.board();
+
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    const Move move = moves[i];
+
+    int score = 10 * Evaluation::capturedValue(board, move) -
+                Evaluation::getPieceValue(board.pieceAt(move.from()));
+
+    if (move.isPromotion()) {
+      score += 10 * Evaluation::getPieceValue(move.promotionType());
+    }
+
+    moves.score(i) = score;
+  }
+}
+
+void MovePicker::scoreQuiets(MoveList& moves) const {
+  const Board& board = m_position.board();
+
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    const Move move = moves[i];
+    //The square orders the moves that have no history yet.
+    int score =
+        10 * Evaluation::getSquareValue(m_position.side(), move.to(), board.pieceAt(move.from()));
+
+    if (m_history) {
+      score += m_history->score(m_position.side(), move);
+    }
+
+    //The piece can be won by the opponent.
+    if (!m_position.see(move, 0)) {
+      score -= Evaluation::LOSING_EXCHANGE_PENALTY;
+    }
+
+    moves.score(i) = score;
+  }
+}
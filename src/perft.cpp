@@ -0,0 +1,217 @@
+#include "perft.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(__MINGW32__) && !defined(_GLIBCXX_HAS_GTHREADS)
+#include "mingw.thread.h"
+#else
+#include <thread>
+#endif
+
+namespace {
+
+//Layout of the data word of a slot. The node count fits in 56 bits.
+constexpr int DEPTH_SHIFT = 56;
+constexpr std::uint64_t NODES_MASK = (1ULL << DEPTH_SHIFT) - 1;
+
+}  // namespace
+
+PerftHashTable::PerftHashTable(std::size_t size_mb) {
+  const std::size_t max_slots = std::max<std::size_t>(size_mb, 1) * 1024 * 1024 / sizeof(Slot);
+
+  //Round down to a power of two so that the index is a single AND.
+  std::size_t num_of_slots = 1;
+
+  while (num_of_slots * 2 <= max_slots) {
+    num_of_slots *= 2;
+  }
+
+  m_slots = std::make_unique<Slot[]>(num_of_slots);
+  m_mask = num_of_slots - 1;
+}
+
+bool PerftHashTable::probe(std::uint64_t key, int depth, std::uint64_t& nodes) const noexcept {
+  const Slot& slot = m_slots[key & m_mask];
+
+  const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+
+  //A torn slot does not match the key.
+  if ((slot.key.load(std::memory_order_relaxed) ^ data) != key ||
+      static_cast<int>(data >> DEPTH_SHIFT) != depth) {
+    return false;
+  }
+
+  nodes = data & NODES_MASK;
+  return true;
+}
+
+void PerftHashTable::store(std::uint64_t key, int depth, std::uint64_t nodes) noexcept {
+  Slot& slot = m_slots[key & m_mask];
+
+  const std::uint64_t data =
+      (static_cast<std::uint64_t>(depth) << DEPTH_SHIFT) | (nodes & NODES_MASK);
+
+  slot.key.store(key ^ data, std::memory_order_relaxed);
+  slot.data.store(data, std::memory_order_relaxed);
+}
+
+namespace Perft {
+namespace {
+
+//Make the move and collect the leaves below it. The depth includes the move.
+void collectMove(Position& position, const Move move, const int depth, PerftData& data) {
+  if (depth == 1) {
+    data.num_of_captures += !position.board().isEmpty(move.to()) ||
+                            move.flag() == Move::EN_PASSANT;
+    data.num_of_en_passant += move.flag() == Move::EN_PASSANT;
+    data.num_of_castles += move.flag() == Move::CASTLING;
+    data.num_of_promotions += move.isPromotion();
+  }
+
+  position.doMove(move);
+
+  if (depth == 1) {
+    data.num_of_checks += position.isInCheck();
+  }
+
+  collect(position, depth - 1, data);
+  position.undoMove(move);
+}
+
+}  // namespace
+
+std::uint64_t count(Position& position, int depth, PerftHashTable* hash_table) {
+  if (depth <= 0) {
+    return 1;
+  }
+
+  std::uint64_t nodes = 0;
+
+  //Only generate the moves when the subtree is not in the table.
+  if (depth > 1 && hash_table && hash_table->probe(position.key(), depth, nodes)) {
+    return nodes;
+  }
+
+  MoveList moves;
+  MoveGenerator::generateLegalMoves(position, moves);
+
+  if (depth == 1) {
+    return moves.size();
+  }
+
+  for (const Move move : moves) {
+    position.doMove(move);
+    nodes += count(position, depth - 1, hash_table);
+    position.undoMove(move);
+  }
+
+  if (hash_table) {
+    hash_table->store(position.key(), depth, nodes);
+  }
+
+  return nodes;
+}
+
+void collect(Position& position, int depth, PerftData& data) {
+  if (depth == 0) {
+    ++data.num_of_positions;
+    return;
+  }
+
+  MoveList moves;
+  MoveGenerator::generateLegalMoves(position, moves);
+
+  for (const Move move : moves) {
+    collectMove(position, move, depth, data);
+  }
+}
+
+Result run(const Position& position, const Options& options) {
+  const auto start_time = std::chrono::steady_clock::now();
+
+  Result result;
+
+  MoveList root_moves;
+  MoveGenerator::generateLegalMoves(position, root_moves);
+
+  std::unique_ptr<PerftHashTable> hash_table;
+
+  if (options.hash_mb > 0 && !options.collect_stats) {
+    hash_table = std::make_unique<PerftHashTable>(options.hash_mb);
+  }
+
+  std::vector<std::uint64_t> counts(root_moves.size(), 0);
+  std::vector<PerftData> data(root_moves.size());
+
+  std::atomic<std::size_t> next_move{0};
+
+  //Every thread searches its own copy of the position.
+  auto work = [&]() {
+    Position copy = position;
+
+    for (std::size_t i = next_move++; i < root_moves.size(); i = next_move++) {
+      if (options.collect_stats) {
+        collectMove(copy, root_moves[i], options.depth, data[i]);
+        counts[i] = data[i].num_of_positions;
+        continue;
+      }
+
+      copy.doMove(root_moves[i]);
+      counts[i] = count(copy, options.depth - 1, hash_table.get());
+      copy.undoMove(root_moves[i]);
+    }
+  };
+
+  if (options.depth <= 0) {
+    result.nodes = 1;
+    result.data.num_of_positions = 1;
+  } else {
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 1; i < options.num_of_threads; ++i) {
+      threads.emplace_back(work);
+    }
+
+    work();
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (std::size_t i = 0; i < root_moves.size(); ++i) {
+    result.divide.emplace_back(root_moves[i], counts[i]);
+    result.nodes += counts[i];
+    result.data += data[i];
+  }
+
+  result.time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start_time)
+                    .count();
+
+  return result;
+}
+
+void print(const Result& result, const Options& options, std::ostream& out) {
+  for (const auto& [move, nodes] : result.divide) {
+    out << MoveGenerator::toUCINotation(move) << ": " << nodes << "\n";
+  }
+
+  out << "\nDepth: " << options.depth << "\n"
+      << "Nodes: " << result.nodes << "\n";
+
+  if (options.collect_stats) {
+    out << "Captures: " << result.data.num_of_captures << "\n"
+        << "En passant: " << result.data.num_of_en_passant << "\n"
+        << "Castles: " << result.data.num_of_castles << "\n"
+        << "Promotions: " << result.data.num_of_promotions << "\n"
+        << "Checks: " << result.data.num_of_checks << "\n";
+  }
+
+  out << "Time: " << result.time << " ms\n"
+      << "Nodes/second: " << result.nodes * 1000 / std::max<std::int64_t>(result.time, 1)
+      << std::endl;
+}
+
+}  // namespace Perft
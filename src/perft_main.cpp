@@ -0,0 +1,49 @@
+#include "perft.hpp"
+#include "attacks.hpp"
+#include "fen_parser.hpp"
+
+#include <algorithm>
+#include <string>
+
+//Usage: neuralchess-perft [--fen FEN] [--depth N] [--threads N] [--hash MB] [--stats]
+int main(int argc, char* argv[]) {
+  Perft::Options options;
+  options.depth = 5;
+
+  std::string fen = FenParser::INITIAL_POSITION;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+
+    if (arg == "--fen" && i + 1 < argc) {
+      fen = argv[++i];
+    } else if (arg == "--depth" && i + 1 < argc) {
+      options.depth = std::max(std::stoi(argv[++i]), 0);
+    } else if (arg == "--threads" && i + 1 < argc) {
+      options.num_of_threads = std::max(std::stoi(argv[++i]), 1);
+    } else if (arg == "--hash" && i + 1 < argc) {
+      options.hash_mb = std::max(std::stoi(argv[++i]), 0);
+    } else if (arg == "--stats") {
+      options.collect_stats = true;
+    } else {
+      std::cerr << "Unknown argument: " << arg << "\n";
+      return 1;
+    }
+  }
+
+  Attacks::init();
+
+  Position position;
+
+  FenParser::getInstance().setVerbose(false);
+  FenParser::getInstance().setFEN(fen);
+
+  if (FenParser::getInstance().init(position) != 0) {
+    std::cerr << "Invalid FEN: " << fen << "\n";
+    return 1;
+  }
+
+  Perft::print(Perft::run(position, options), options);
+
+  return 0;
+}
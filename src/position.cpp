@@ -0,0 +1,489 @@
+#include "position.hpp"
+#include "engine_globals.hpp"
+#include "move.hpp"
+#include "evaluation.hpp"
+#include "attacks.hpp"
+#include "zobrist_hashing.hpp"
+
+namespace {
+
+//The 0th rank of the mailbox is the 8th rank of the chess board.
+constexpr int WHITE_BACK_RANK = Bitboard::BOARD_SIZE;
+constexpr int BLACK_BACK_RANK = 0;
+
+constexpr int KING_FILE = 4;
+
+//Castling rights that are kept when a piece leaves or lands on the square.
+int castlingRightsMask(int square) {
+  const int white_shift = Bitboard::Sides::WHITE;
+
+  switch (square) {
+    case (WHITE_BACK_RANK << 3) + KING_FILE:
+      return ~((Bitboard::Castle::SHORT_CASTLE | Bitboard::Castle::LONG_CASTLE) << white_shift);
+    case (WHITE_BACK_RANK << 3) + Bitboard::BOARD_SIZE:
+      return ~(Bitboard::Castle::SHORT_CASTLE << white_shift);
+    case (WHITE_BACK_RANK << 3):
+      return ~(Bitboard::Castle::LONG_CASTLE << white_shift);
+    case (BLACK_BACK_RANK << 3) + KING_FILE:
+      return ~(Bitboard::Castle::SHORT_CASTLE | Bitboard::Castle::LONG_CASTLE);
+    case (BLACK_BACK_RANK << 3) + Bitboard::BOARD_SIZE:
+      return ~Bitboard::Castle::SHORT_CASTLE;
+    case (BLACK_BACK_RANK << 3):
+      return ~Bitboard::Castle::LONG_CASTLE;
+    default:
+      return ~0;
+  }
+}
+
+//The rook squares of a castling move, given the squares of the king.
+void castlingRookSquares(const int from, const int to, int& rook_from, int& rook_to) {
+  const bool is_long_castle = to < from;
+
+  rook_from = from + (is_long_castle ? -4 : 3);
+  rook_to = to + (is_long_castle ? 1 : -1);
+}
+
+//The square of the pawn captured en passant by a pawn of the side.
+int enPassantCaptureSquare(const int side, const int to) {
+  return to + (side & Bitboard::Sides::WHITE ? 8 : -8);
+}
+
+}  // namespace
+
+Position::Position() {
+  m_states.reserve(STATE_STACK_RESERVE);
+  m_states.emplace_back();
+}
+
+void Position::set(const Board& board, int side, int castling, int en_passant,
+                   int halfmove_clock) {
+  m_board = board;
+  m_side = side;
+
+  StateInfo state;
+
+  state.castling = castling;
+  state.en_passant = en_passant;
+  state.halfmove_clock = halfmove_clock;
+
+  m_states.clear();
+  m_states.push_back(state);
+
+  m_states.back().key = computeKey();
+}
+
+void Position::removePiece(int square) {
+  m_board.removePiece(square);
+  m_states.back().key = computeKey();
+}
+
+void Position::doMove(Move move) {
+  const ZobristHashing& zobrist = *Globals::zobrist_hashing;
+
+  const int from = move.from();
+  const int to = move.to();
+
+  const int moved_piece = m_board.pieceAt(from);
+  const int captured_piece = m_board.pieceAt(to);
+
+  StateInfo state = m_states.back();
+
+  state.captured_piece = captured_piece;
+
+  //Only XOR the keys of the squares and the state that change.
+  std::uint64_t key = state.key ^ zobrist.sideKey() ^ zobrist.castlingKey(state.castling);
+
+  if (!(state.en_passant & Bitboard::Squares::no_sq)) {
+    key ^= zobrist.enPassantKey(state.en_passant);
+  }
+
+  if (captured_piece != Bitboard::Pieces::e) {
+    key ^= zobrist.pieceKey(captured_piece, to);
+  }
+
+  ++state.halfmove_clock;
+  ++state.plies_from_null;
+
+  if (captured_piece != Bitboard::Pieces::e || Bitboard::isPawn(moved_piece)) {
+    state.halfmove_clock = 0;
+  }
+
+  m_board.movePiece(from, to);
+
+  if (move.isPromotion()) {
+    m_board.putPiece(to, Bitboard::pieceOfSide(move.promotionType(), m_side));
+  }
+
+  key ^= zobrist.pieceKey(moved_piece, from) ^ zobrist.pieceKey(m_board.pieceAt(to), to);
+
+  if (move.flag() == Move::EN_PASSANT) {
+    const int capture_square = enPassantCaptureSquare(m_side, to);
+
+    key ^= zobrist.pieceKey(m_board.pieceAt(capture_square), capture_square);
+    m_board.removePiece(capture_square);
+  }
+
+  if (move.flag() == Move::CASTLING) {
+    int rook_from = 0;
+    int rook_to = 0;
+
+    castlingRookSquares(from, to, rook_from, rook_to);
+
+    m_board.movePiece(rook_from, rook_to);
+
+    const int rook = m_board.pieceAt(rook_to);
+    key ^= zobrist.pieceKey(rook, rook_from) ^ zobrist.pieceKey(rook, rook_to);
+  }
+
+  //Moving the king or a rook, or capturing a rook, loses castling rights.
+  state.castling &= castlingRightsMask(from) & castlingRightsMask(to);
+
+  //A double pawn push allows en passant only if an enemy pawn can capture it.
+  state.en_passant = Bitboard::Squares::no_sq;
+
+  if (Bitboard::isPawn(moved_piece) && std::abs(to - from) == 16) {
+    const int en_passant_square = (to + from) >> 1;
+    const int enemy_pawn = Bitboard::pieceOfSide(Bitboard::Pieces::P, m_side ^ 0b11);
+
+    if (Attacks::pawnAttacks(m_side, en_passant_square) & m_board.pieces(enemy_pawn)) {
+      state.en_passant = en_passant_square;
+      key ^= zobrist.enPassantKey(en_passant_square);
+    }
+  }
+
+  key ^= zobrist.castlingKey(state.castling);
+
+  state.key = key;
+
+  m_states.push_back(state);
+  m_side ^= 0b11;
+}
+
+void Position::undoMove(Move move) {
+  m_side ^= 0b11;
+
+  const int from = move.from();
+  const int to = move.to();
+
+  if (move.flag() == Move::CASTLING) {
+    int rook_from = 0;
+    int rook_to = 0;
+
+    castlingRookSquares(from, to, rook_from, rook_to);
+
+    m_board.movePiece(rook_to, rook_from);
+  }
+
+  const int moved_piece = move.isPromotion() ? Bitboard::pieceOfSide(Bitboard::Pieces::P, m_side)
+                                             : m_board.pieceAt(to);
+
+  m_board.putPiece(from, moved_piece);
+  m_board.putPiece(to, m_states.back().captured_piece);
+
+  if (move.flag() == Move::EN_PASSANT) {
+    m_board.putPiece(enPassantCaptureSquare(m_side, to),
+                     Bitboard::pieceOfSide(Bitboard::Pieces::P, m_side ^ 0b11));
+  }
+
+  m_states.pop_back();
+}
+
+void Position::doNullMove() {
+  const ZobristHashing& zobrist = *Globals::zobrist_hashing;
+
+  StateInfo state = m_states.back();
+
+  state.key ^= zobrist.sideKey();
+  state.captured_piece = Bitboard::Pieces::e;
+
+  //A pass still counts for the fifty-move rule, but no position before it
+  //can repeat after it.
+  ++state.halfmove_clock;
+  state.plies_from_null = 0;
+
+  if (!(state.en_passant & Bitboard::Squares::no_sq)) {
+    state.key ^= zobrist.enPassantKey(state.en_passant);
+    state.en_passant = Bitboard::Squares::no_sq;
+  }
+
+  m_states.push_back(state);
+  m_side ^= 0b11;
+}
+
+void Position::undoNullMove() {
+  m_states.pop_back();
+  m_side ^= 0b11;
+}
+
+bool Position::isInCheck() const noexcept {
+  const int king = kingSquare();
+
+  if (king & Bitboard::Squares::no_sq) {
+    return false;
+  }
+
+  return m_board.isSquareAttacked(king, m_side ^ 0b11);
+}
+
+Bitboard::U64 Position::checkers() const noexcept {
+  const int king = kingSquare();
+
+  if (king & Bitboard::Squares::no_sq) {
+    return Bitboard::EMPTY_BITBOARD;
+  }
+
+  return m_board.attackersTo(king, m_board.occupancy()) & m_board.occupancy(m_side ^ 0b11);
+}
+
+Bitboard::U64 Position::pinnedPieces() const noexcept {
+  const int king = kingSquare();
+  const int opponent = m_side ^ 0b11;
+
+  if (king & Bitboard::Squares::no_sq) {
+    return Bitboard::EMPTY_BITBOARD;
+  }
+
+  const Bitboard::U64 enemies = m_board.occupancy(opponent);
+  const Bitboard::U64 queens = m_board.pieces(Bitboard::pieceOfSide(Bitboard::Pieces::Q, opponent));
+
+  //Enemy sliders that would attack the king if our pieces were not in the way.
+  Bitboard::U64 snipers =
+      (Attacks::rookAttacks(king, enemies) &
+       (m_board.pieces(Bitboard::pieceOfSide(Bitboard::Pieces::R, opponent)) | queens)) |
+      (Attacks::bishopAttacks(king, enemies) &
+       (m_board.pieces(Bitboard::pieceOfSide(Bitboard::Pieces::B, opponent)) | queens));
+
+  Bitboard::U64 pinned = Bitboard::EMPTY_BITBOARD;
+
+  while (snipers) {
+    const Bitboard::U64 blockers =
+        Attacks::between(king, Bitboard::popLSB(snipers)) & m_board.occupancy();
+
+    //A lone blocker of our own color is pinned.
+    if (blockers && !Bitboard::moreThanOne(blockers) && (blockers & m_board.occupancy(m_side))) {
+      pinned |= blockers;
+    }
+  }
+
+  return pinned;
+}
+
+bool Position::givesCheck(Move move) const noexcept {
+  using namespace Bitboard;
+
+  const int opponent = m_side ^ 0b11;
+  const int king = m_board.kingSquare(opponent);
+
+  if (king & Squares::no_sq) {
+    return false;
+  }
+
+  const int from = move.from();
+  const int to = move.to();
+
+  const int piece =
+      move.isPromotion() ? pieceOfSide(move.promotionType(), m_side) : m_board.pieceAt(from);
+
+  U64 occupancy = (m_board.occupancy() ^ squareBit(from)) | squareBit(to);
+  U64 our_pieces = m_board.occupancy(m_side) ^ squareBit(from);
+
+  if (move.flag() == Move::EN_PASSANT) {
+    occupancy ^= squareBit(enPassantCaptureSquare(m_side, to));
+  }
+
+  //The moved piece checks from its target square. For castling it is the rook.
+  U64 attacks = EMPTY_BITBOARD;
+
+  if (move.flag() == Move::CASTLING) {
+    int rook_from = 0;
+    int rook_to = 0;
+
+    castlingRookSquares(from, to, rook_from, rook_to);
+
+    occupancy ^= squareBit(rook_from) | squareBit(rook_to);
+    our_pieces ^= squareBit(rook_from);
+
+    attacks = Attacks::rookAttacks(rook_to, occupancy);
+  } else if (isPawn(piece)) {
+    attacks = Attacks::pawnAttacks(m_side, to);
+  } else if (isKnight(piece)) {
+    attacks = Attacks::knightAttacks(to);
+  } else if (isSlidingPiece(piece)) {
+    attacks = Attacks::sliderAttacks(piece, to, occupancy);
+  }
+
+  if (attacks & squareBit(king)) {
+    return true;
+  }
+
+  //The pieces that did not move check through the squares left behind.
+  const U64 queens = m_board.pieces(pieceOfSide(Pieces::Q, m_side));
+  const U64 rooks_queens = (m_board.pieces(pieceOfSide(Pieces::R, m_side)) | queens) & our_pieces;
+  const U64 bishops_queens =
+      (m_board.pieces(pieceOfSide(Pieces::B, m_side)) | queens) & our_pieces;
+
+  return (Attacks::rookAttacks(king, occupancy) & rooks_queens) ||
+         (Attacks::bishopAttacks(king, occupancy) & bishops_queens);
+}
+
+bool Position::see(Move move, int threshold) const noexcept {
+  using namespace Bitboard;
+
+  //Castling can not lose material, and promotions and en passant are rare
+  //enough to be given the benefit of the doubt.
+  if (move.flag() != Move::NORMAL) {
+    return threshold <= 0;
+  }
+
+  const int from = move.from();
+  const int to = move.to();
+
+  //The balance after the capture, from the side to move's point of view, minus
+  //the threshold. It fails if the capture alone is not enough...
+  int swap = Evaluation::getPieceValue(m_board.pieceAt(to)) - threshold;
+
+  if (swap < 0) {
+    return false;
+  }
+
+  //...and succeeds if it is enough even when the capturing piece is lost.
+  swap = Evaluation::getPieceValue(m_board.pieceAt(from)) - swap;
+
+  if (swap <= 0) {
+    return true;
+  }
+
+  const U64 bishops_queens = m_board.pieces(Pieces::B) | m_board.pieces(Pieces::b) |
+                             m_board.pieces(Pieces::Q) | m_board.pieces(Pieces::q);
+  const U64 rooks_queens = m_board.pieces(Pieces::R) | m_board.pieces(Pieces::r) |
+                           m_board.pieces(Pieces::Q) | m_board.pieces(Pieces::q);
+
+  U64 occupancy = m_board.occupancy() ^ squareBit(from) ^ squareBit(to);
+  U64 attackers = m_board.attackersTo(to, occupancy);
+
+  int side = m_side;
+
+  //1 while the side that made the last capture comes out ahead.
+  int result = 1;
+
+  //The sides take turns capturing on the square with their least valuable
+  //attacker. A capture removes the attacker from the occupancy, which
+  //uncovers the sliders behind it. (X-rays)
+  while (true) {
+    side ^= 0b11;
+    attackers &= occupancy;
+
+    const U64 side_attackers = attackers & m_board.occupancy(side);
+
+    if (!side_attackers) {
+      break;
+    }
+
+    result ^= 1;
+
+    U64 attacker = EMPTY_BITBOARD;
+    int type = Pieces::P;
+
+    for (const int candidate : {Pieces::P, Pieces::N, Pieces::B, Pieces::R, Pieces::Q}) {
+      attacker = side_attackers & m_board.pieces(pieceOfSide(candidate, side));
+
+      if (attacker) {
+        type = candidate;
+        break;
+      }
+    }
+
+    //The king can only capture if the opponent has no attacker left.
+    if (!attacker) {
+      return (attackers & ~m_board.occupancy(side)) ? result ^ 1 : result;
+    }
+
+    swap = Evaluation::getPieceValue(type) - swap;
+
+    if (swap < result) {
+      break;
+    }
+
+    occupancy ^= squareBit(getLSB(attacker));
+
+    if (type == Pieces::P || type == Pieces::B || type == Pieces::Q) {
+      attackers |= Attacks::bishopAttacks(to, occupancy) & bishops_queens;
+    }
+
+    if (type == Pieces::R || type == Pieces::Q) {
+      attackers |= Attacks::rookAttacks(to, occupancy) & rooks_queens;
+    }
+  }
+
+  return result;
+}
+
+bool Position::isInsufficientMaterial() const noexcept {
+  // If there are pawns, then it is not insufficient due to pawn promotion.
+  if (m_board.pieces(Bitboard::Pieces::P) | m_board.pieces(Bitboard::Pieces::p)) {
+    return false;
+  }
+
+  const int BISHOP_VALUE = Evaluation::getPieceValue(Bitboard::Pieces::B);
+
+  int material = 0;
+
+  // Sum the material of both sides, excluding the kings.
+  for (int type = Bitboard::Pieces::Q; type <= Bitboard::Pieces::p; ++type) {
+    if (Bitboard::isKing(type)) {
+      continue;
+    }
+
+    material += Bitboard::popCount(m_board.pieces(type)) * Evaluation::getPieceValue(type);
+  }
+
+  return material <= BISHOP_VALUE;
+}
+
+bool Position::isThreefoldRepetition() const noexcept {
+  //No position before the last capture, pawn move or null move can repeat.
+  const int window = std::min(halfmoveClock(), state().plies_from_null);
+
+  const std::uint64_t current_key = key();
+
+  int occurrences = 1;
+
+  //Only the positions with the same side to move can be identical.
+  for (int distance = 2; distance <= window; distance += 2) {
+    if (m_states[m_states.size() - 1 - distance].key == current_key && ++occurrences >= 3) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool Position::isFiftyMoveRule() const noexcept {
+  return halfmoveClock() >= MoveGenerator::HALFMOVE_CLOCK_THRESHOLD;
+}
+
+std::uint64_t Position::computeKey() const {
+  const ZobristHashing& zobrist = *Globals::zobrist_hashing;
+
+  std::uint64_t key = 0;
+
+  for (int piece = Bitboard::Pieces::K; piece <= Bitboard::Pieces::p; ++piece) {
+    Bitboard::U64 squares = m_board.pieces(piece);
+
+    while (squares) {
+      key ^= zobrist.pieceKey(piece, Bitboard::popLSB(squares));
+    }
+  }
+
+  if (m_side & Bitboard::Sides::BLACK) {
+    key ^= zobrist.sideKey();
+  }
+
+  key ^= zobrist.castlingKey(castling());
+
+  if (!(enPassant() & Bitboard::Squares::no_sq)) {
+    key ^= zobrist.enPassantKey(enPassant());
+  }
+
+  return key;
+}
@@ -0,0 +1,43 @@
+#include "time_manager.hpp"
+
+#include <algorithm>
+
+namespace {
+
+//Never plan more moves ahead than this, even if the time control is longer.
+constexpr int MAX_MOVES_TO_GO = 50;
+
+}  // namespace
+
+void TimeManager::init(const SearchLimits& limits) {
+  m_start_time = std::chrono::steady_clock::now();
+
+  m_is_time_limited = !limits.infinite && (limits.move_time > 0 || limits.time > 0);
+
+  m_optimum_time = 0;
+  m_maximum_time = 0;
+
+  if (!m_is_time_limited) {
+    return;
+  }
+
+  if (limits.move_time > 0) {
+    m_optimum_time = m_maximum_time = std::max<std::int64_t>(limits.move_time - MOVE_OVERHEAD, 1);
+    return;
+  }
+
+  const int moves_to_go = limits.moves_to_go > 0 ? std::min(limits.moves_to_go, MAX_MOVES_TO_GO)
+                                                 : DEFAULT_MOVES_TO_GO;
+
+  const std::int64_t available = std::max<std::int64_t>(limits.time - MOVE_OVERHEAD, 1);
+
+  //Spend an even share of the remaining time, plus most of the increment.
+  m_optimum_time = available / moves_to_go + limits.increment * 3 / 4;
+
+  //An unstable search may overrun the optimum time, but it must never use up
+  //the whole clock.
+  m_maximum_time = std::min(m_optimum_time * 4, available * 4 / 5);
+  m_maximum_time = std::max<std::int64_t>(m_maximum_time, 1);
+
+  m_optimum_time = std::min(m_optimum_time, m_maximum_time);
+}
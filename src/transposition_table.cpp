@@ -0,0 +1,213 @@
+#include "transposition_table.hpp"
+
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+//Layout of the data word of a slot.
+constexpr int SCORE_SHIFT = 16;
+constexpr int DEPTH_SHIFT = 32;
+constexpr int BOUND_SHIFT = 40;
+constexpr int GENERATION_SHIFT = 42;
+
+constexpr std::uint64_t GENERATION_MASK = 0x3F;
+
+//Number of buckets sampled by hashfull().
+constexpr std::size_t HASHFULL_SAMPLE = 1000;
+
+std::uint64_t pack(const int depth, const int score, const TranspositionTable::Bound bound,
+                   const Move move, const std::uint8_t generation) {
+  return static_cast<std::uint64_t>(move.raw()) |
+         (static_cast<std::uint64_t>(static_cast<std::uint16_t>(score)) << SCORE_SHIFT) |
+         (static_cast<std::uint64_t>(static_cast<std::uint8_t>(depth)) << DEPTH_SHIFT) |
+         (static_cast<std::uint64_t>(bound) << BOUND_SHIFT) |
+         (static_cast<std::uint64_t>(generation & GENERATION_MASK) << GENERATION_SHIFT);
+}
+
+Move moveOf(const std::uint64_t data) {
+  return Move::fromRaw(static_cast<std::uint16_t>(data));
+}
+
+int scoreOf(const std::uint64_t data) {
+  return static_cast<std::int16_t>(data >> SCORE_SHIFT);
+}
+
+int depthOf(const std::uint64_t data) {
+  return static_cast<std::int8_t>(data >> DEPTH_SHIFT);
+}
+
+TranspositionTable::Bound boundOf(const std::uint64_t data) {
+  return static_cast<TranspositionTable::Bound>((data >> BOUND_SHIFT) & 0b11);
+}
+
+std::uint8_t generationOf(const std::uint64_t data) {
+  return static_cast<std::uint8_t>((data >> GENERATION_SHIFT) & GENERATION_MASK);
+}
+
+}  // namespace
+
+TranspositionTable::TranspositionTable(std::size_t size_mb) {
+  resize(size_mb);
+}
+
+TranspositionTable::~TranspositionTable() {}
+
+void TranspositionTable::resize(std::size_t size_mb) {
+  const std::size_t max_buckets = std::max<std::size_t>(size_mb, 1) * 1024 * 1024 / sizeof(Bucket);
+
+  //Round down to a power of two so that the index is a single AND.
+  std::size_t num_of_buckets = 1;
+
+  while (num_of_buckets * 2 <= max_buckets) {
+    num_of_buckets *= 2;
+  }
+
+  m_buckets = std::make_unique<Bucket[]>(num_of_buckets);
+  m_mask = num_of_buckets - 1;
+  m_size_mb = size_mb;
+
+  clear();
+}
+
+void TranspositionTable::clear() {
+  for (std::size_t i = 0; i <= m_mask; ++i) {
+    for (Slot& slot : m_buckets[i].slots) {
+      slot.key.store(0, std::memory_order_relaxed);
+      slot.data.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  m_generation = 0;
+  resetStats();
+}
+
+void TranspositionTable::newSearch() noexcept {
+  m_generation = (m_generation + 1) & GENERATION_MASK;
+}
+
+bool TranspositionTable::probe(std::uint64_t key, Entry& entry) const noexcept {
+#if defined(TT_STATS)
+  m_probes.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+  for (const Slot& slot : bucketOf(key).slots) {
+    const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+
+    //A torn or foreign slot fails the XOR check.
+    if (data == 0 || (slot.key.load(std::memory_order_relaxed) ^ data) != key) {
+      continue;
+    }
+
+    entry.move = moveOf(data);
+    entry.score = scoreOf(data);
+    entry.depth = depthOf(data);
+    entry.bound = boundOf(data);
+
+#if defined(TT_STATS)
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+    return true;
+  }
+
+  return false;
+}
+
+void TranspositionTable::store(std::uint64_t key, int depth, int score, Bound bound,
+                               Move move) noexcept {
+  Bucket& bucket = bucketOf(key);
+
+  Slot* replace = &bucket.slots[0];
+  int lowest_value = INT_MAX;
+
+  [[maybe_unused]] bool is_same_position = false;
+
+  for (Slot& slot : bucket.slots) {
+    const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+
+    if (data == 0) {
+      replace = &slot;
+      lowest_value = INT_MIN;
+      continue;
+    }
+
+    if ((slot.key.load(std::memory_order_relaxed) ^ data) == key) {
+      //Keep the deeper entry of the current search, and its move.
+      if (bound != BOUND_EXACT && generationOf(data) == m_generation &&
+          depth < depthOf(data) - 2) {
+        return;
+      }
+
+      if (move.isNull()) {
+        move = moveOf(data);
+      }
+
+      replace = &slot;
+      is_same_position = true;
+
+      break;
+    }
+
+    //Replace the shallowest entry, preferring the ones of older searches.
+    const int age = (m_generation - generationOf(data)) & GENERATION_MASK;
+    const int value = depthOf(data) - 8 * age;
+
+    if (value < lowest_value) {
+      lowest_value = value;
+      replace = &slot;
+    }
+  }
+
+#if defined(TT_STATS)
+  if (!is_same_position && replace->data.load(std::memory_order_relaxed) != 0) {
+    m_collisions.fetch_add(1, std::memory_order_relaxed);
+  }
+#endif
+
+  const std::uint64_t data = pack(depth, score, bound, move, m_generation);
+
+  replace->key.store(key ^ data, std::memory_order_relaxed);
+  replace->data.store(data, std::memory_order_relaxed);
+
+#if defined(TT_STATS)
+  m_stores.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+int TranspositionTable::hashfull() const noexcept {
+  const std::size_t samples = std::min(HASHFULL_SAMPLE, m_mask + 1);
+
+  int used = 0;
+
+  for (std::size_t i = 0; i < samples; ++i) {
+    for (const Slot& slot : m_buckets[i].slots) {
+      const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+      used += data != 0 && generationOf(data) == m_generation;
+    }
+  }
+
+  return static_cast<int>(used * 1000 / (samples * BUCKET_SIZE));
+}
+
+TranspositionTable::Stats TranspositionTable::stats() const noexcept {
+  Stats stats;
+
+#if defined(TT_STATS)
+  stats.probes = m_probes.load(std::memory_order_relaxed);
+  stats.hits = m_hits.load(std::memory_order_relaxed);
+  stats.stores = m_stores.load(std::memory_order_relaxed);
+  stats.collisions = m_collisions.load(std::memory_order_relaxed);
+#endif
+
+  return stats;
+}
+
+void TranspositionTable::resetStats() noexcept {
+#if defined(TT_STATS)
+  m_probes.store(0, std::memory_order_relaxed);
+  m_hits.store(0, std::memory_order_relaxed);
+  m_stores.store(0, std::memory_order_relaxed);
+  m_collisions.store(0, std::memory_order_relaxed);
+#endif
+}
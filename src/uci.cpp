@@ -0,0 +1,256 @@
+#include "uci.hpp"
+#include "attacks.hpp"
+#include "bench.hpp"
+#include "fen_parser.hpp"
+#include "transposition_table.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+UCI::UCI() {
+  Attacks::init();
+
+  //Only the protocol may be written to stdout.
+  FenParser::getInstance().setVerbose(false);
+  FenParser::getInstance().setFEN(FenParser::INITIAL_POSITION);
+  FenParser::getInstance().init(m_position);
+
+  m_search.setInfoCallback([this](const SearchInfo& info) { reportInfo(info); });
+}
+
+UCI::~UCI() {
+  stopSearch();
+}
+
+void UCI::loop(std::istream& input) {
+  std::string command;
+
+  while (std::getline(input, command)) {
+    if (!execute(command)) {
+      return;
+    }
+  }
+}
+
+bool UCI::execute(const std::string& command) {
+  std::istringstream stream(command);
+
+  std::string token;
+  stream >> token;
+
+  if (token == "uci") {
+    uci();
+  } else if (token == "isready") {
+    send("readyok");
+  } else if (token == "setoption") {
+    setOption(stream);
+  } else if (token == "ucinewgame") {
+    stopSearch();
+    Globals::transposition_table->clear();
+    m_search.clearHistory();
+  } else if (token == "position") {
+    setPosition(stream);
+  } else if (token == "go") {
+    go(stream);
+  } else if (token == "stop") {
+    stopSearch();
+  } else if (token == "ponderhit") {
+    m_search.ponderhit();
+  } else if (token == "bench") {
+    bench(stream);
+  } else if (token == "quit") {
+    stopSearch();
+    return false;
+  }
+
+  return true;
+}
+
+void UCI::uci() {
+  send(std::string("id name ") + ENGINE_NAME);
+  send(std::string("id author ") + ENGINE_AUTHOR);
+
+  send("option name Hash type spin default " +
+       std::to_string(TranspositionTable::DEFAULT_SIZE_MB) + " min 1 max " +
+       std::to_string(MAX_HASH_MB));
+  send("option name Threads type spin default 1 min 1 max " + std::to_string(MAX_THREADS));
+  send("option name Ponder type check default false");
+
+  send("uciok");
+}
+
+void UCI::setOption(std::istringstream& stream) {
+  std::string token;
+  std::string name;
+  std::string value;
+
+  stream >> token;  //"name"
+
+  //The name may contain spaces.
+  while (stream >> token && token != "value") {
+    name += (name.empty() ? "" : " ") + token;
+  }
+
+  stream >> value;
+
+  //The options can not be changed while thinking.
+  stopSearch();
+
+  if (name == "Hash" && !value.empty()) {
+    Globals::transposition_table->resize(std::clamp(std::atoi(value.c_str()), 1, MAX_HASH_MB));
+  } else if (name == "Threads" && !value.empty()) {
+    m_search.setNumOfThreads(std::clamp(std::atoi(value.c_str()), 1, MAX_THREADS));
+  }
+}
+
+void UCI::setPosition(std::istringstream& stream) {
+  std::string token;
+  std::string fen;
+
+  stream >> token;
+
+  if (token == "startpos") {
+    fen = FenParser::INITIAL_POSITION;
+    stream >> token;  //"moves"
+  } else if (token == "fen") {
+    while (stream >> token && token != "moves") {
+      fen += token + " ";
+    }
+  } else {
+    return;
+  }
+
+  stopSearch();
+
+  Position position;
+
+  FenParser::getInstance().setFEN(fen);
+
+  if (FenParser::getInstance().init(position) != 0) {
+    send("info string invalid fen " + fen);
+    return;
+  }
+
+  //Stop at the first move that is not legal.
+  while (stream >> token) {
+    const Move move = MoveGenerator::fromUCINotation(position, token);
+
+    if (move.isNull()) {
+      send("info string illegal move " + token);
+      break;
+    }
+
+    position.doMove(move);
+  }
+
+  m_position = position;
+}
+
+void UCI::go(std::istringstream& stream) {
+  SearchLimits limits;
+
+  const bool is_white = m_position.side() & Bitboard::Sides::WHITE;
+
+  std::string token;
+
+  while (stream >> token) {
+    if (token == "wtime" || token == "btime") {
+      std::int64_t time = 0;
+      stream >> time;
+
+      if ((token == "wtime") == is_white) {
+        limits.time = time;
+      }
+    } else if (token == "winc" || token == "binc") {
+      std::int64_t increment = 0;
+      stream >> increment;
+
+      if ((token == "winc") == is_white) {
+        limits.increment = increment;
+      }
+    } else if (token == "movestogo") {
+      stream >> limits.moves_to_go;
+    } else if (token == "movetime") {
+      stream >> limits.move_time;
+    } else if (token == "depth") {
+      stream >> limits.max_depth;
+    } else if (token == "nodes") {
+      stream >> limits.max_nodes;
+    } else if (token == "infinite") {
+      limits.infinite = true;
+    } else if (token == "ponder") {
+      limits.ponder = true;
+    }
+  }
+
+  stopSearch();
+
+  m_pv.clear();
+
+  //A stop that arrives before the thread reaches think() must still stop it.
+  m_search.clearStop();
+
+  m_search_thread = std::thread([this, limits, root = m_position]() {
+    const Move best_move = m_search.think(root, limits);
+
+    std::string line = "bestmove " + MoveGenerator::toUCINotation(best_move);
+
+    if (m_pv.size() > 1 && m_pv[0] == best_move) {
+      line += " ponder " + MoveGenerator::toUCINotation(m_pv[1]);
+    }
+
+    send(line);
+  });
+}
+
+void UCI::bench(std::istringstream& stream) {
+  int depth = Bench::DEFAULT_DEPTH;
+  stream >> depth;
+
+  stopSearch();
+
+  std::lock_guard<std::mutex> lock(m_output_mutex);
+  Bench::run(std::max(depth, 1), std::cout);
+}
+
+void UCI::reportInfo(const SearchInfo& info) {
+  m_pv = info.pv;
+
+  const std::uint64_t nps = info.nodes * 1000 / std::max<std::int64_t>(info.time, 1);
+
+  std::string line = "info depth " + std::to_string(info.depth) + " seldepth " +
+                     std::to_string(info.seldepth) + " score " + scoreToUCI(info.score) +
+                     " nodes " + std::to_string(info.nodes) + " nps " + std::to_string(nps) +
+                     " hashfull " + std::to_string(info.hashfull) + " time " +
+                     std::to_string(info.time) + " pv";
+
+  for (const Move move : info.pv) {
+    line += " " + MoveGenerator::toUCINotation(move);
+  }
+
+  send(line);
+}
+
+void UCI::stopSearch() {
+  if (m_search_thread.joinable()) {
+    m_search.stop();
+    m_search_thread.join();
+  }
+}
+
+void UCI::send(const std::string& line) {
+  std::lock_guard<std::mutex> lock(m_output_mutex);
+  std::cout << line << std::endl;
+}
+
+std::string UCI::scoreToUCI(int score) {
+  if (std::abs(score) < Evaluation::MATE_IN_MAX_PLY) {
+    return "cp " + std::to_string(score);
+  }
+
+  //Mate in N plies is mate in (N + 1) / 2 moves.
+  const int plies = Evaluation::MATE_SCORE - std::abs(score);
+  const int moves = (plies + 1) / 2;
+
+  return "mate " + std::to_string(score > 0 ? moves : -moves);
+}
@@ -0,0 +1,23 @@
+#include "uci.hpp"
+
+#include <string>
+
+//The arguments are run as a single command, like "neuralchess-uci bench 5".
+int main(int argc, char* argv[]) {
+  UCI uci;
+
+  if (argc > 1) {
+    std::string command;
+
+    for (int i = 1; i < argc; ++i) {
+      command += std::string(argv[i]) + " ";
+    }
+
+    uci.execute(command);
+    return 0;
+  }
+
+  uci.loop();
+
+  return 0;
+}
@@ -12,33 +12,30 @@ const ZobristTable& ZobristHashing::getZobristTable() const {
 }
 
 void ZobristHashing::init() {
-  m_random_number_generator = std::mt19937_64(m_random_device());
+  //A fixed seed keeps the hashes of a position identical across runs.
+  m_random_number_generator = std::mt19937_64(0x5EED5EED5EED5EEDULL);
   
   distribution = std::uniform_int_distribution<unsigned long long>(
       0, std::numeric_limits<unsigned long long>::max());
 
-  // Resize the zobrist table to accommodate the 64 squares and 12 different piece types
-  m_zobrist_table.resize(64ULL, std::vector<std::uint64_t>(12ULL));
-
   // Generate random numbers for each square and piece combination
   for (int square = 0; square < Bitboard::NUM_OF_SQUARES; ++square) {
-    for (int piece = 0; piece < 12; ++piece) {
+    for (int piece = 0; piece < Bitboard::NUM_OF_PIECE_TYPES; ++piece) {
       m_zobrist_table[square][piece] = distribution(m_random_number_generator);
     }
   }
-}
 
-const std::uint64_t ZobristHashing::hashPosition() {
-  std::uint64_t hash = 0;
+  m_side_key = distribution(m_random_number_generator);
 
-  // Iterate over the bitboard and XOR the corresponding random number from the zobrist table
-  for (int square = 0; square < Bitboard::NUM_OF_SQUARES; ++square) {
-    const int piece = Globals::bitboard[square];
-    
-    if (piece != Bitboard::Pieces::e) {
-      hash ^= m_zobrist_table[square][piece];
-    }
+  //No castling rights must not change the hash.
+  m_castling_keys[0] = 0;
+
+  for (std::size_t rights = 1; rights < m_castling_keys.size(); ++rights) {
+    m_castling_keys[rights] = distribution(m_random_number_generator);
+  }
+
+  for (std::uint64_t& key : m_en_passant_keys) {
+    key = distribution(m_random_number_generator);
   }
+}
 
-  return hash;
-}
\ No newline at end of file
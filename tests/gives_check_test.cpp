@@ -0,0 +1,100 @@
+#include "attacks.hpp"
+#include "fen_parser.hpp"
+#include "move_picker.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+//Checks that Position::givesCheck agrees with making the move and testing
+//Position::isInCheck, for every move of the tree below every position of an
+//EPD file. Futility pruning relies on it for discovered checks, en passant,
+//castling and promotions.
+//
+//Usage: gives_check_test <file.epd> [--depth N]
+
+namespace {
+
+//Returns the number of moves of the tree for which the two disagree.
+int countMismatches(Position& position, int depth) {
+  MoveList moves;
+  MoveGenerator::generateLegalMoves(position, moves);
+
+  int num_of_mismatches = 0;
+
+  for (const Move move : moves) {
+    const bool gives_check = position.givesCheck(move);
+
+    position.doMove(move);
+
+    if (gives_check != position.isInCheck()) {
+      std::cout << "  " << MoveGenerator::toUCINotation(move) << ": givesCheck() is "
+                << (gives_check ? "true" : "false") << "\n";
+      ++num_of_mismatches;
+    }
+
+    if (depth > 1) {
+      num_of_mismatches += countMismatches(position, depth - 1);
+    }
+
+    position.undoMove(move);
+  }
+
+  return num_of_mismatches;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: gives_check_test <file.epd> [--depth N]\n";
+    return 2;
+  }
+
+  std::ifstream file(argv[1]);
+
+  if (!file) {
+    std::cerr << "Can not open " << argv[1] << "\n";
+    return 2;
+  }
+
+  int depth = 3;
+
+  for (int i = 2; i < argc; ++i) {
+    const std::string arg = argv[i];
+
+    if (arg == "--depth" && i + 1 < argc) {
+      depth = std::stoi(argv[++i]);
+    }
+  }
+
+  Attacks::init();
+  FenParser::getInstance().setVerbose(false);
+
+  int num_of_failures = 0;
+
+  std::string line;
+
+  while (std::getline(file, line)) {
+    const std::string fen = line.substr(0, line.find(';'));
+
+    if (fen.empty()) {
+      continue;
+    }
+
+    Position position;
+
+    FenParser::getInstance().setFEN(fen);
+
+    const bool passed =
+        FenParser::getInstance().init(position) == 0 && countMismatches(position, depth) == 0;
+
+    std::cout << (passed ? "ok   " : "FAIL ") << fen << "\n";
+
+    num_of_failures += !passed;
+  }
+
+  std::cout << "\nFailures: " << num_of_failures << std::endl;
+
+  return num_of_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include "attacks.hpp"
+#include "fen_parser.hpp"
+#include "move_picker.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+//Checks that a MovePicker yields every legal move exactly once, whatever the
+//move of the transposition table, the killers and the counter move are, on
+//every position of an EPD file and on the positions one move away from them.
+//
+//Usage: move_picker_test <file.epd>
+
+namespace {
+
+bool yieldsLegalMoves(const Position& position, const Move tt_move,
+                      const KillerTable::Killers& killers, const Move counter_move) {
+  MoveList legal_moves;
+  MoveGenerator::generateLegalMoves(position, legal_moves);
+
+  const HistoryTable history;
+
+  MovePicker move_picker(position, tt_move, killers, counter_move, history);
+  std::size_t num_of_moves = 0;
+
+  for (Move move = move_picker.next(); !move.isNull(); move = move_picker.next()) {
+    Move* const found = std::find(legal_moves.begin(), legal_moves.end(), move);
+
+    if (found == legal_moves.end()) {
+      return false;
+    }
+
+    //Every move can only be found once.
+    *found = Move();
+    ++num_of_moves;
+  }
+
+  return num_of_moves == legal_moves.size();
+}
+
+bool testPosition(Position& position) {
+  MoveList moves;
+  MoveGenerator::generateLegalMoves(position, moves);
+
+  //A move of another position, which must not be yielded.
+  const Move foreign_move(0, 63);
+
+  if (!yieldsLegalMoves(position, Move(), {}, Move()) ||
+      !yieldsLegalMoves(position, foreign_move, {foreign_move, foreign_move}, foreign_move)) {
+    return false;
+  }
+
+  //Every move as the move of the table, a killer or the counter move, even the
+  //captures and the same move twice.
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    const Move move = moves[i];
+    const Move other = moves[(i + 1) % moves.size()];
+
+    if (!yieldsLegalMoves(position, move, {other, move}, other) ||
+        !yieldsLegalMoves(position, Move(), {move, foreign_move}, other)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: move_picker_test <file.epd>\n";
+    return 2;
+  }
+
+  std::ifstream file(argv[1]);
+
+  if (!file) {
+    std::cerr << "Can not open " << argv[1] << "\n";
+    return 2;
+  }
+
+  Attacks::init();
+  FenParser::getInstance().setVerbose(false);
+
+  int num_of_failures = 0;
+
+  std::string line;
+
+  while (std::getline(file, line)) {
+    const std::string fen = line.substr(0, line.find(';'));
+
+    if (fen.empty()) {
+      continue;
+    }
+
+    Position position;
+
+    FenParser::getInstance().setFEN(fen);
+
+    bool passed = FenParser::getInstance().init(position) == 0 && testPosition(position);
+
+    MoveList moves;
+    MoveGenerator::generateLegalMoves(position, moves);
+
+    for (const Move move : moves) {
+      position.doMove(move);
+      passed = passed && testPosition(position);
+      position.undoMove(move);
+    }
+
+    std::cout << (passed ? "ok   " : "FAIL ") << fen << "\n";
+
+    num_of_failures += !passed;
+  }
+
+  std::cout << "\nFailures: " << num_of_failures << std::endl;
+
+  return num_of_failures == 0 ? 0 : 1;
+}
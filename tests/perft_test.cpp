@@ -0,0 +1,144 @@
+#include "perft.hpp"
+#include "attacks.hpp"
+#include "fen_parser.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//Runs perft on every position of an EPD file and compares the counts with the
+//expected ones. Every line holds a FEN followed by ";D<depth> <nodes>" fields.
+//
+//Usage: perft_test <file.epd> [--max-depth N] [--threads N] [--hash MB]
+
+namespace {
+
+struct Expectation {
+  int depth;
+  std::uint64_t nodes;
+};
+
+struct TestCase {
+  std::string fen;
+  std::vector<Expectation> expectations;
+};
+
+bool parseLine(const std::string& line, TestCase& test_case) {
+  std::stringstream ss(line);
+  std::string field;
+
+  if (!std::getline(ss, test_case.fen, ';')) {
+    return false;
+  }
+
+  while (std::getline(ss, field, ';')) {
+    std::stringstream field_stream(field);
+
+    std::string depth;
+    Expectation expectation{0, 0};
+
+    if (field_stream >> depth >> expectation.nodes && depth.size() > 1 && depth[0] == 'D') {
+      expectation.depth = std::stoi(depth.substr(1));
+      test_case.expectations.push_back(expectation);
+    }
+  }
+
+  return !test_case.expectations.empty();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: perft_test <file.epd> [--max-depth N] [--threads N] [--hash MB]\n";
+    return 2;
+  }
+
+  int max_depth = 0;
+
+  Perft::Options options;
+
+  for (int i = 2; i + 1 < argc; i += 2) {
+    const std::string arg = argv[i];
+
+    if (arg == "--max-depth") {
+      max_depth = std::stoi(argv[i + 1]);
+    } else if (arg == "--threads") {
+      options.num_of_threads = std::max(std::stoi(argv[i + 1]), 1);
+    } else if (arg == "--hash") {
+      options.hash_mb = std::max(std::stoi(argv[i + 1]), 0);
+    }
+  }
+
+  std::ifstream file(argv[1]);
+
+  if (!file) {
+    std::cerr << "Can not open " << argv[1] << "\n";
+    return 2;
+  }
+
+  Attacks::init();
+  FenParser::getInstance().setVerbose(false);
+
+  int num_of_failures = 0;
+  std::uint64_t total_nodes = 0;
+  std::int64_t total_time = 0;
+
+  std::string line;
+
+  while (std::getline(file, line)) {
+    TestCase test_case;
+
+    if (!parseLine(line, test_case)) {
+      continue;
+    }
+
+    Position position;
+
+    FenParser::getInstance().setFEN(test_case.fen);
+
+    if (FenParser::getInstance().init(position) != 0) {
+      std::cout << "FAIL invalid fen: " << test_case.fen << "\n";
+      ++num_of_failures;
+      continue;
+    }
+
+    for (const Expectation& expectation : test_case.expectations) {
+      if (max_depth > 0 && expectation.depth > max_depth) {
+        continue;
+      }
+
+      options.depth = expectation.depth;
+
+      const Perft::Result result = Perft::run(position, options);
+      const bool passed = result.nodes == expectation.nodes;
+
+      total_nodes += result.nodes;
+      total_time += result.time;
+
+      std::cout << (passed ? "ok   " : "FAIL ") << "D" << expectation.depth << " "
+                << std::setw(10) << result.nodes << " nodes " << std::setw(12)
+                << result.nodes * 1000 / std::max<std::int64_t>(result.time, 1) << " nps  "
+                << test_case.fen;
+
+      if (!passed) {
+        std::cout << " (expected " << expectation.nodes << ")";
+        ++num_of_failures;
+      }
+
+      std::cout << "\n";
+    }
+  }
+
+  std::cout << "\nNodes: " << total_nodes << "\n"
+            << "Time: " << total_time << " ms\n"
+            << "Nodes/second: " << total_nodes * 1000 / std::max<std::int64_t>(total_time, 1)
+            << "\n"
+            << "Failures: " << num_of_failures << std::endl;
+
+  return num_of_failures == 0 ? 0 : 1;
+}
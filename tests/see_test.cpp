@@ -0,0 +1,69 @@
+#include "attacks.hpp"
+#include "fen_parser.hpp"
+#include "move.hpp"
+
+#include <iostream>
+
+//Checks Position::see against exchanges whose outcome is known. The value is
+//the material the side to move wins with the move, so the move must pass a
+//threshold of the value and fail a threshold of the value plus one.
+
+namespace {
+
+struct TestCase {
+  const char* fen;
+  const char* move;
+  int value;
+};
+
+constexpr TestCase TEST_CASES[] = {
+    //An undefended pawn.
+    {"1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", "e1e5", 100},
+    //A knight for a pawn, with x-rays behind both sides.
+    {"1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1", "d3e5", -200},
+    {"4k3/8/8/3p4/4P3/8/8/4K3 w - - 0 1", "e4d5", 100},
+    {"4k3/8/2p5/3p4/4P3/8/8/4K3 w - - 0 1", "e4d5", 0},
+    {"4k3/8/2p5/3p4/8/8/3Q4/4K3 w - - 0 1", "d2d5", -800},
+    //The rook behind the first rook joins the exchange.
+    {"3rk3/8/8/3p4/8/8/3R4/3RK3 w - - 0 1", "d2d5", 100},
+    {"3rk3/3r4/8/3p4/8/8/3R4/3RK3 w - - 0 1", "d2d5", -400},
+    //The king only recaptures when no attacker of the opponent is left.
+    {"3rk3/8/8/3p4/4K3/8/8/3R4 w - - 0 1", "d1d5", 100},
+    {"3rk3/1b6/8/3p4/4K3/8/8/3R4 w - - 0 1", "d1d5", -400},
+    {"4k3/8/8/8/8/8/4q3/4K3 w - - 0 1", "e1e2", 900},
+    //A quiet move to a square attacked by a pawn.
+    {"4k3/8/8/3p4/8/2N5/8/4K3 w - - 0 1", "c3e4", -300},
+    {"4k3/8/8/8/8/2N5/8/4K3 w - - 0 1", "c3e4", 0},
+    //Castling never loses material.
+    {"4k3/8/8/8/8/8/8/4K2R w K - 0 1", "e1g1", 0},
+};
+
+}  // namespace
+
+int main() {
+  Attacks::init();
+  FenParser::getInstance().setVerbose(false);
+
+  int num_of_failures = 0;
+
+  for (const TestCase& test_case : TEST_CASES) {
+    Position position;
+
+    FenParser::getInstance().setFEN(test_case.fen);
+
+    const Move move = FenParser::getInstance().init(position) == 0
+                          ? MoveGenerator::fromUCINotation(position, test_case.move)
+                          : Move();
+
+    const bool passed = move != Move() && position.see(move, test_case.value) &&
+                        !position.see(move, test_case.value + 1);
+
+    std::cout << (passed ? "ok   " : "FAIL ") << test_case.move << " " << test_case.fen << "\n";
+
+    num_of_failures += !passed;
+  }
+
+  std::cout << "\nFailures: " << num_of_failures << std::endl;
+
+  return num_of_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#include "attacks.hpp"
+#include "fen_parser.hpp"
+#include "minimax_search.hpp"
+#include "transposition_table.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//Searches every position of an EPD file to a fixed depth and checks that the
+//best move is one of the expected ones, so that the forward pruning does not
+//lose the tactics. Every line holds a FEN followed by a ";bm" field with the
+//moves in long algebraic notation.
+//
+//Usage: tactics_test <file.epd> [--depth N]
+
+namespace {
+
+struct TestCase {
+  std::string fen;
+  std::vector<std::string> best_moves;
+};
+
+bool parseLine(const std::string& line, TestCase& test_case) {
+  std::stringstream ss(line);
+  std::string field;
+
+  if (!std::getline(ss, test_case.fen, ';')) {
+    return false;
+  }
+
+  while (std::getline(ss, field, ';')) {
+    std::stringstream field_stream(field);
+
+    std::string opcode;
+    std::string move;
+
+    if (field_stream >> opcode && opcode == "bm") {
+      while (field_stream >> move) {
+        test_case.best_moves.push_back(move);
+      }
+    }
+  }
+
+  return !test_case.best_moves.empty();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: tactics_test <file.epd> [--depth N]\n";
+    return 2;
+  }
+
+  std::ifstream file(argv[1]);
+
+  if (!file) {
+    std::cerr << "Can not open " << argv[1] << "\n";
+    return 2;
+  }
+
+  SearchLimits limits;
+  limits.max_depth = 8;
+
+  for (int i = 2; i < argc; ++i) {
+    const std::string arg = argv[i];
+
+    if (arg == "--depth" && i + 1 < argc) {
+      limits.max_depth = std::stoi(argv[++i]);
+    }
+  }
+
+  Attacks::init();
+  FenParser::getInstance().setVerbose(false);
+
+  Search search;
+
+  int num_of_failures = 0;
+
+  std::string line;
+
+  while (std::getline(file, line)) {
+    TestCase test_case;
+
+    if (!parseLine(line, test_case)) {
+      continue;
+    }
+
+    Position position;
+
+    FenParser::getInstance().setFEN(test_case.fen);
+
+    std::string found = "invalid fen";
+
+    if (FenParser::getInstance().init(position) == 0) {
+      //Every position starts from the same state, whatever ran before it.
+      Globals::transposition_table->clear();
+      search.clearHistory();
+      search.clearStop();
+
+      found = MoveGenerator::toUCINotation(search.think(position, limits));
+    }
+
+    const bool passed = std::find(test_case.best_moves.begin(), test_case.best_moves.end(),
+                                  found) != test_case.best_moves.end();
+
+    std::cout << (passed ? "ok   " : "FAIL ") << test_case.fen << " (" << found << ")\n";
+
+    num_of_failures += !passed;
+  }
+
+  std::cout << "\nFailures: " << num_of_failures << std::endl;
+
+  return num_of_failures == 0 ? 0 : 1;
+}
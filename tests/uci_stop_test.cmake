@@ -0,0 +1,24 @@
+# Sends "go infinite" and an immediate "stop" to the UCI engine, which must
+# still answer with a bestmove. A stop sent before the search thread starts
+# must not be lost.
+#
+# Usage: cmake -DUCI=<neuralchess-uci> -DWORK_DIR=<dir> -P uci_stop_test.cmake
+
+set(input_file "${WORK_DIR}/uci_stop_input.txt")
+file(WRITE "${input_file}" "go infinite\nstop\nquit\n")
+
+execute_process(
+  COMMAND "${UCI}"
+  INPUT_FILE "${input_file}"
+  OUTPUT_VARIABLE output
+  RESULT_VARIABLE result
+  TIMEOUT 10
+)
+
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "neuralchess-uci did not exit: ${result}\n${output}")
+endif()
+
+if(NOT output MATCHES "(^|\n)bestmove ")
+  message(FATAL_ERROR "No bestmove after stop:\n${output}")
+endif()